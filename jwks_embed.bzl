@@ -0,0 +1,56 @@
+"""Compiles a fixed key set into a C++ library."""
+
+def cc_embedded_jwks(
+        name,
+        src,
+        symbol,
+        namespace = "",
+        type = "jwks",
+        **kwargs):
+    """Generates a cc_library holding the decoded keys of a JWKS or PEM file.
+
+    The library has a header "<name>.h" declaring
+
+        extern const ::google::jwt_verify::EmbeddedJwks <symbol>;
+
+    in the given namespace, to be loaded with Jwks::createFromEmbedded().
+    The key set is parsed at build time, so a bad key set fails the build.
+
+    Args:
+      name: name of the cc_library.
+      src: the JWKS, x509 key map or PEM bundle file.
+      symbol: name of the EmbeddedJwks constant.
+      namespace: C++ namespace of the constant, e.g. "my::keys".
+      type: "jwks" for a JWKS or x509 key map, "pem" for a PEM bundle.
+      **kwargs: passed to the cc_library, e.g. visibility.
+    """
+    tool = Label("//:jwks_embed")
+    header = name + ".h"
+    source = name + ".cc"
+    package = native.package_name()
+    include = package + "/" + header if package else header
+
+    native.genrule(
+        name = name + "_gen",
+        srcs = [src],
+        outs = [header, source],
+        tools = [tool],
+        cmd = " ".join([
+            "$(location %s)" % tool,
+            "--type=" + type,
+            "--symbol=" + symbol,
+            "--namespace=" + namespace,
+            "--include=" + include,
+            "--out_h=$(location %s)" % header,
+            "--out_cc=$(location %s)" % source,
+            "$(location %s)" % src,
+        ]),
+    )
+
+    native.cc_library(
+        name = name,
+        srcs = [source],
+        hdrs = [header],
+        deps = [Label("//:jwt_verify_lib")],
+        **kwargs
+    )
@@ -15,10 +15,10 @@
 #pragma once
 
 #include <memory>
-#include <set>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_set.h"
 #include "jwt_verify_lib/status.h"
 
 namespace google {
@@ -37,14 +37,15 @@ class CheckAudience {
   CheckAudience(const std::vector<std::string>& config_audiences);
 
   // Check any of jwt_audiences is matched with one of configurated ones.
+  // The audiences are sanitized as views, so the check allocates nothing.
   bool areAudiencesAllowed(const std::vector<std::string>& jwt_audiences) const;
 
   // check if config audiences is empty
   bool empty() const { return config_audiences_.empty(); }
 
  private:
-  // configured audiences;
-  std::set<std::string> config_audiences_;
+  // configured audiences, looked up by string_view.
+  absl::flat_hash_set<std::string> config_audiences_;
 };
 
 typedef std::unique_ptr<CheckAudience> CheckAudiencePtr;
@@ -0,0 +1,113 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "jwt_verify_lib/claim_path.h"
+#include "jwt_verify_lib/jwt_claims.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * Extracts a fixed list of claims from JwtClaims in a single walk over
+ * their members.
+ *
+ * The claim paths are merged into a tree when the extractor is built, so
+ * that each member of the payload, and of the nested objects on the paths,
+ * is looked up once however many claims are extracted. Each claim gets the
+ * FindResult the JwtClaims getter of its type would return.
+ *
+ * An extractor is immutable and may be shared by threads.
+ *
+ * Usage example:
+ *   static const ClaimExtractor* extractor = new ClaimExtractor({
+ *       {"email", ClaimExtractor::Type::String},
+ *       {"realm_access.roles", ClaimExtractor::Type::StringList},
+ *   });
+ *   std::vector<ClaimExtractor::Result> results(extractor->size());
+ *   extractor->extract(jwt.payload_claims_, results.data());
+ */
+class ClaimExtractor {
+ public:
+  using FindResult = StructUtils::FindResult;
+
+  // The type a claim is read as, with the JwtClaims getter of that name.
+  // Claim only finds it, whatever its type.
+  enum class Type {
+    Claim,
+    String,
+    UInt64,
+    Int64,
+    Double,
+    Boolean,
+    StringList,
+  };
+
+  struct Spec {
+    Spec(absl::string_view nested_names, Type type)
+        : path(nested_names), type(type) {}
+    ClaimPath path;
+    Type type;
+  };
+
+  // The value of a claim. Only the member of its type is set.
+  struct Result {
+    FindResult code = StructUtils::MISSING;
+    // The claim found, if code is not MISSING.
+    const JwtClaims::Claim* claim = nullptr;
+    // A view of the claim, valid as long as the JwtClaims.
+    absl::string_view string_value;
+    uint64_t uint64_value = 0;
+    int64_t int64_value = 0;
+    double double_value = 0;
+    bool bool_value = false;
+    std::vector<std::string> string_list;
+  };
+
+  explicit ClaimExtractor(const std::vector<Spec>& specs);
+
+  // The number of claims, and results that extract() fills.
+  size_t size() const { return specs_.size(); }
+  const std::vector<Spec>& specs() const { return specs_; }
+
+  // Fills results[i] with the claim of specs()[i], for every i < size().
+  void extract(const JwtClaims& claims, Result* results) const;
+
+ private:
+  // A name in the tree of claim paths.
+  struct Node {
+    // The nodes of the names that follow this one.
+    absl::flat_hash_map<std::string, size_t> children;
+    // The specs whose path ends at this name.
+    std::vector<size_t> specs;
+  };
+
+  void walk(size_t node, const JwtClaims& claims, Result* results) const;
+  // Fails the claims below node, when its claim is not an object.
+  void failBelow(size_t node, Result* results) const;
+
+  const std::vector<Spec> specs_;
+  // The root, at index 0, has the first names of the paths as children.
+  std::vector<Node> nodes_;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,54 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * A nested claim name, e.g. "a.b.c", split into its names once.
+ *
+ * StructUtils and JwtClaims split a nested name on every lookup. A
+ * ClaimPath is meant to be built at config time and reused for every
+ * token: its lookups probe with the names it holds, and allocate nothing.
+ *
+ * Usage example:
+ *   const ClaimPath path("realm_access.roles");
+ *   ...
+ *   std::vector<std::string> roles;
+ *   jwt.payload_claims_.GetStringList(path, &roles);
+ */
+class ClaimPath {
+ public:
+  // Splits nested_names on '.', like the nested name lookups do.
+  explicit ClaimPath(absl::string_view nested_names);
+
+  // The nested name the path was built from.
+  const std::string& path() const { return path_; }
+  // The names in the path, never empty.
+  const std::vector<std::string>& names() const { return names_; }
+
+ private:
+  std::string path_;
+  std::vector<std::string> names_;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
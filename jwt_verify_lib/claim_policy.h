@@ -0,0 +1,131 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "jwt_verify_lib/claim_path.h"
+#include "jwt_verify_lib/jwt.h"
+#include "jwt_verify_lib/jwt_claims.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * A list of rules on the claims of a token, compiled into a plan when the
+ * policy is built.
+ *
+ * The plan runs the cheap rules first, e.g. an equality before a list
+ * intersection, so a failing token is rejected with the least work. The
+ * string constants of the rules are interned, and each claim is looked up
+ * once however many rules read it. Evaluating a token allocates nothing
+ * once its Lookups have grown to the policy, except when JwtClaims indexes
+ * a nested object on the first lookup into it, or a list element with
+ * escapes outgrows the buffer of the Lookups.
+ *
+ * A policy is immutable and may be shared by threads.
+ *
+ * Usage example:
+ *   static const ClaimPolicy* policy = new ClaimPolicy({
+ *       {"issuer", "iss", ClaimPolicy::Op::Prefix, {"https://idp.example/"}},
+ *       {"tenant", "tid", ClaimPolicy::Op::Equals, {"acme"}},
+ *       {"roles", "realm.roles", ClaimPolicy::Op::Intersects, {"a", "b"}},
+ *   });
+ *   ClaimPolicy::Lookups lookups;
+ *   const ClaimPolicy::Rule* failed = policy->evaluate(jwt, &lookups);
+ *   if (failed != nullptr) { ... failed->name ... }
+ */
+class ClaimPolicy {
+ public:
+  // The check of a rule, in the order of their cost.
+  enum class Op {
+    // The claim exists, whatever its type.
+    Exists,
+    // The claim is a string equal to one of the values.
+    Equals,
+    // The claim is a string that starts with one of the values.
+    Prefix,
+    // The claim is a string or list of string, like "aud", with one of the
+    // values.
+    Intersects,
+  };
+
+  struct Rule {
+    // The name of the rule, for diagnostics.
+    std::string name;
+    // The nested name of the claim, e.g. "realm.roles".
+    std::string claim;
+    Op op;
+    std::vector<std::string> values;
+  };
+
+  // The claims of a token that a policy looked up. Reusing one for each
+  // token avoids allocating.
+  class Lookups {
+   private:
+    friend class ClaimPolicy;
+
+    struct Lookup {
+      bool done = false;
+      const JwtClaims::Claim* claim = nullptr;
+    };
+    std::vector<Lookup> lookups_;
+    // For the list elements that have escapes.
+    std::string buffer_;
+  };
+
+  explicit ClaimPolicy(const std::vector<Rule>& rules);
+
+  const std::vector<Rule>& rules() const { return rules_; }
+
+  // Returns the first rule of the plan that claims fail, or nullptr if
+  // they pass every rule.
+  const Rule* evaluate(const JwtClaims& claims, Lookups* lookups) const;
+  // Same, for the payload claims of jwt.
+  const Rule* evaluate(const Jwt& jwt, Lookups* lookups) const;
+
+ private:
+  // A rule of the plan.
+  struct Step {
+    // The index of the rule, and of its claim in claims_.
+    size_t rule;
+    size_t claim;
+    Op op;
+    // The values, as views of constants_.
+    std::vector<absl::string_view> values;
+    // The values hashed, for Equals and Intersects with many values.
+    absl::flat_hash_set<absl::string_view> value_set;
+  };
+
+  // Whether the claim passes the step.
+  bool check(const Step& step, const JwtClaims::Claim& claim,
+             Lookups* lookups) const;
+  // Whether value is one of the values of the step.
+  static bool isValue(const Step& step, absl::string_view value);
+
+  const std::vector<Rule> rules_;
+  // The distinct values of the rules, which the steps point into.
+  std::vector<std::string> constants_;
+  // The distinct claims of the rules.
+  std::vector<ClaimPath> claims_;
+  // The rules, cheap ones first.
+  std::vector<Step> plan_;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,183 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "jwt_verify_lib/jwt_claims.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * Reads a claim into a member of type M. Specialized for each supported
+ * member type, with the JwtClaims converter of that type.
+ */
+template <typename M>
+struct ClaimConverter {
+  static_assert(sizeof(M) == 0,
+                "Claims bind to std::string, absl::string_view, uint64_t, "
+                "int64_t, double, bool or std::vector<std::string> members");
+};
+
+template <>
+struct ClaimConverter<std::string> {
+  static StructUtils::FindResult convert(const JwtClaims::Claim& claim,
+                                         std::string* value) {
+    return JwtClaims::ToString(claim, value);
+  }
+};
+
+// The view is valid as long as the JwtClaims.
+template <>
+struct ClaimConverter<absl::string_view> {
+  static StructUtils::FindResult convert(const JwtClaims::Claim& claim,
+                                         absl::string_view* value) {
+    return JwtClaims::ToString(claim, value);
+  }
+};
+
+template <>
+struct ClaimConverter<uint64_t> {
+  static StructUtils::FindResult convert(const JwtClaims::Claim& claim,
+                                         uint64_t* value) {
+    return JwtClaims::ToUInt64(claim, value);
+  }
+};
+
+template <>
+struct ClaimConverter<int64_t> {
+  static StructUtils::FindResult convert(const JwtClaims::Claim& claim,
+                                         int64_t* value) {
+    return JwtClaims::ToInt64(claim, value);
+  }
+};
+
+template <>
+struct ClaimConverter<double> {
+  static StructUtils::FindResult convert(const JwtClaims::Claim& claim,
+                                         double* value) {
+    return JwtClaims::ToDouble(claim, value);
+  }
+};
+
+template <>
+struct ClaimConverter<bool> {
+  static StructUtils::FindResult convert(const JwtClaims::Claim& claim,
+                                         bool* value) {
+    return JwtClaims::ToBoolean(claim, value);
+  }
+};
+
+// A string or a list of strings, like "aud".
+template <>
+struct ClaimConverter<std::vector<std::string>> {
+  static StructUtils::FindResult convert(const JwtClaims::Claim& claim,
+                                         std::vector<std::string>* value) {
+    value->clear();
+    return JwtClaims::ToStringList(claim, value);
+  }
+};
+
+/**
+ * Binds a member of T to a top level claim name.
+ */
+template <typename T, typename M>
+struct ClaimBinding {
+  absl::string_view name;
+  M T::*member;
+};
+
+template <typename T, typename M>
+constexpr ClaimBinding<T, M> bindClaim(absl::string_view name, M T::*member) {
+  return {name, member};
+}
+
+/**
+ * Reads a fixed set of top level claims into the members of a struct T.
+ *
+ * The member types are checked when the schema is compiled: a member of a
+ * type that no claim converts to fails to compile. Binding walks the
+ * payload members once, and compares each name with the bound names in an
+ * unrolled sequence, without hashing or building a Struct. Nested claims
+ * are read with ClaimExtractor instead.
+ *
+ * Usage example:
+ *   struct Identity {
+ *     std::string tenant;
+ *     std::vector<std::string> roles;
+ *     uint64_t exp;
+ *   };
+ *   static constexpr auto kIdentitySchema = makeClaimSchema(
+ *       bindClaim("tenant", &Identity::tenant),
+ *       bindClaim("roles", &Identity::roles),
+ *       bindClaim("exp", &Identity::exp));
+ *
+ *   Identity identity;
+ *   auto codes = kIdentitySchema.bind(jwt.payload_claims_, &identity);
+ *   if (codes[0] != StructUtils::OK) { ... }
+ */
+template <typename T, typename... Ms>
+class ClaimSchema {
+ public:
+  static constexpr size_t kSize = sizeof...(Ms);
+  // The FindResult of each binding, in the order of the bindings.
+  using Codes = std::array<StructUtils::FindResult, kSize>;
+
+  constexpr explicit ClaimSchema(ClaimBinding<T, Ms>... bindings)
+      : bindings_(bindings...) {}
+
+  // Reads the bound claims of claims into out. A member whose claim is
+  // missing is left as is, and one whose claim has another type may be
+  // partly set, like the JwtClaims getters do.
+  Codes bind(const JwtClaims& claims, T* out) const {
+    Codes codes;
+    codes.fill(StructUtils::MISSING);
+    for (const JwtClaims::Claim& claim : claims.claims()) {
+      bindMember(claim, out, &codes, std::index_sequence_for<Ms...>());
+    }
+    return codes;
+  }
+
+ private:
+  // Reads claim into the member of the first binding with its name.
+  template <size_t... I>
+  void bindMember(const JwtClaims::Claim& claim, T* out, Codes* codes,
+                  std::index_sequence<I...>) const {
+    (void)((claim.name == std::get<I>(bindings_).name &&
+            ((*codes)[I] = ClaimConverter<Ms>::convert(
+                 claim, &(out->*std::get<I>(bindings_).member)),
+             true)) ||
+           ...);
+  }
+
+  std::tuple<ClaimBinding<T, Ms>...> bindings_;
+};
+
+template <typename T, typename... Ms>
+constexpr ClaimSchema<T, Ms...> makeClaimSchema(
+    ClaimBinding<T, Ms>... bindings) {
+  return ClaimSchema<T, Ms...>(bindings...);
+}
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,56 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * A key of a key set compiled into the binary. Tables of them are generated
+ * by the jwks_embed tool, see cc_embedded_jwks in jwks_embed.bzl, and loaded
+ * with Jwks::createFromEmbedded(). All the pointers refer to static data.
+ */
+struct EmbeddedJwk {
+  const char* kid;
+  const char* alg;
+  // "RSA", "EC", "oct" or "OKP".
+  const char* kty;
+  // The curve of "EC" and "OKP" keys, otherwise empty.
+  const char* crv;
+  // The decoded key material: the big-endian "n" and "e" of an RSA key, "x"
+  // and "y" of an EC key, "k" of an oct key and "x" of an OKP key.
+  const uint8_t* first;
+  size_t first_size;
+  const uint8_t* second;
+  size_t second_size;
+  // The thumbprints of the key, see Jwks::Pubkey.
+  const char* thumbprint;
+  const char* x5t;
+  const char* x5t_s256;
+};
+
+/**
+ * A key set compiled into the binary.
+ */
+struct EmbeddedJwks {
+  const EmbeddedJwk* keys;
+  size_t size;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,132 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * A pull parser reading a JSON document one value at a time, without
+ * building a tree of it.
+ *
+ * Read with beginObject() at the top level, it accepts the same documents
+ * as protobuf's JsonStringToMessage into a google::protobuf::Struct, so that
+ * it can replace it without changing which inputs are rejected: member
+ * names must be unique within an object, strings must be valid UTF-8 and
+ * numbers must fit a double. Like protobuf's parser, it also accepts
+ * trailing commas in objects and arrays, single-quoted strings and unquoted
+ * member names.
+ *
+ * Every value must be consumed by one of the read functions, skipValue(),
+ * or beginObject() / beginArray() followed by nextMember() / nextElement()
+ * until they return false. Once a call fails, all later calls fail and
+ * failed() is true.
+ *
+ * Usage example:
+ *   JsonReader reader(json);
+ *   absl::string_view name;
+ *   if (reader.beginObject()) {
+ *     while (reader.nextMember(&name)) {
+ *       if (name == "kid") {
+ *         reader.readString(&kid);
+ *       } else {
+ *         reader.skipValue();
+ *       }
+ *     }
+ *   }
+ *   if (!reader.done()) { ... }
+ */
+class JsonReader {
+ public:
+  enum class Type { Invalid, Null, Bool, Number, String, Object, Array };
+
+  // Constructing a reader allocates nothing.
+  explicit JsonReader(absl::string_view json);
+  JsonReader(const JsonReader&) = delete;
+  JsonReader& operator=(const JsonReader&) = delete;
+
+  // Returns the type of the next value without consuming it, or
+  // Type::Invalid if the next token does not start a value.
+  Type peek();
+
+  bool readNull();
+  bool readBool(bool* value);
+  // Reads a number as its JSON text, e.g. "-1.5e3".
+  bool readNumber(absl::string_view* text);
+  bool readNumber(double* value);
+  bool readString(std::string* value);
+  // Reads a string as a view of the input if it has no escapes. Otherwise
+  // it is decoded into buffer, which the view then points into.
+  bool readString(absl::string_view* value, std::string* buffer);
+  // Consumes the next value, checking its syntax.
+  bool skipValue();
+
+  // Consumes the start of an object, or of an array.
+  bool beginObject();
+  bool beginArray();
+  // Moves to the next member of the innermost object and sets name to its
+  // name, which stays valid as long as the reader. Returns false, having
+  // consumed the end of the object, if there are no more members.
+  bool nextMember(absl::string_view* name);
+  // Moves to the next element of the innermost array. Returns false, having
+  // consumed the end of the array, if there are no more elements.
+  bool nextElement();
+
+  // Returns true if the whole document was read without error.
+  bool done();
+  bool failed() const { return failed_; }
+  // The offset in the input of the next character to read.
+  size_t offset() const { return pos_; }
+
+ private:
+  bool fail();
+  void skipWhitespace();
+  // Consumes c, after any whitespace, if it is the next character.
+  bool consume(char c);
+  bool enter();
+  void leave();
+  bool scanLiteral(absl::string_view literal);
+  bool scanNumber(absl::string_view* text, double* value);
+  bool scanString(absl::string_view* value, std::string* buffer);
+  bool scanName(absl::string_view* name);
+
+  const absl::string_view json_;
+  size_t pos_ = 0;
+  bool failed_ = false;
+  // True right after the "{" or "[" of the innermost object or array, when
+  // its first entry needs no comma.
+  bool at_start_ = false;
+  // The member names of each open object, indexed by its depth, to reject
+  // duplicates. The sets are kept to be reused by later objects.
+  size_t depth_ = 0;
+  std::vector<absl::flat_hash_set<absl::string_view>> names_;
+  // Storage of member names that had escapes, created for the first one so
+  // that a reader allocates nothing for documents without them. And
+  // scratch space for strings that are skipped.
+  std::unique_ptr<std::deque<std::string>> decoded_names_;
+  std::string scratch_;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
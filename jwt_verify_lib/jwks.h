@@ -14,9 +14,15 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "jwt_verify_lib/embedded_jwks.h"
+#include "jwt_verify_lib/jwk_set.pb.h"
 #include "jwt_verify_lib/status.h"
 #include "openssl/ec.h"
 #include "openssl/evp.h"
@@ -25,6 +31,8 @@
 namespace google {
 namespace jwt_verify {
 
+class JsonReader;
+
 /**
  *  Class to parse and a hold JSON Web Key Set.
  *
@@ -34,47 +42,204 @@ namespace jwt_verify {
  */
 class Jwks : public WithStatus {
  public:
-  // Format of public key.
-  enum Type { JWKS, PEM };
+  // Format of public key. PROTO is a serialized JwkSet message, see
+  // jwk_set.proto.
+  enum Type { JWKS, PEM, PROTO };
+
+  // Options to control how a key set is loaded.
+  struct LoadOptions {
+    // If true, RSA and EC keys in a JWKS only keep their raw base64url fields
+    // at load time, after a cheap syntax check. The OpenSSL key object is
+    // built on first use, see Pubkey::materialize().
+    bool lazy = false;
+    // If true, keys loaded from an x509 key map keep their certificate in
+    // Pubkey::x509_. By default only the public key is kept.
+    bool retain_x509 = false;
+    // Number of threads loadJwksDirectory() parses files on. 0 uses one
+    // thread per core.
+    int threads = 0;
+  };
+
+  // The status of one file loaded by loadJwksDirectory().
+  struct FileStatus {
+    std::string path;
+    Status status;
+  };
 
   // Create from string
   static std::unique_ptr<Jwks> createFrom(const std::string& pkey, Type type);
+  // Create from string with load options.
+  static std::unique_ptr<Jwks> createFrom(const std::string& pkey, Type type,
+                                          const LoadOptions& options);
   // Executes to createFrom with type=PEM and sets additional JWKS paramaters
   // not specified within the PEM.
   static std::unique_ptr<Jwks> createFromPem(const std::string& pkey,
                                              const std::string& kid,
                                              const std::string& alg);
 
+  // kid and alg of a key in a PEM bundle.
+  struct PemKeyInfo {
+    std::string kid;
+    std::string alg;
+  };
+
+  // Create from a bundle of PEM "PUBLIC KEY" and "CERTIFICATE" blocks, read
+  // in a single pass. The key of the i-th block takes its kid and alg from
+  // key_infos[i] if there is one, like createFromPem. Otherwise its kid is
+  // its RFC 7638 thumbprint and its alg is empty. Blocks that fail to parse
+  // are skipped; the status is Ok if any key was loaded.
+  static std::unique_ptr<Jwks> createFromPemBundle(
+      const std::string& bundle, const std::vector<PemKeyInfo>& key_infos = {});
+
+  // The required members of a JWK its RFC 7638 thumbprint is computed from:
+  // "e" and "n" for RSA, "crv", "x" and "y" for EC, "crv" and "x" for OKP.
+  struct ThumbprintMembers {
+    absl::string_view kty;
+    absl::string_view crv;
+    absl::string_view e;
+    absl::string_view n;
+    absl::string_view x;
+    absl::string_view y;
+  };
+
+  // Computes the base64url RFC 7638 thumbprint of a JWK. The members are
+  // decoded and encoded again in their canonical form, e.g. "n" without
+  // leading zero octets, so that every encoding of a key, and every way of
+  // loading it, gets the same thumbprint. Returns empty for key types other
+  // than RSA, EC and OKP, or if a member is not base64url.
+  static std::string computeThumbprint(const ThumbprintMembers& members);
+
+  // Create from a key set compiled into the binary by cc_embedded_jwks. The
+  // keys are built from their decoded key material, without any parsing.
+  // Like keys in a JWKS, invalid keys are skipped.
+  static std::unique_ptr<Jwks> createFromEmbedded(const EmbeddedJwks& embedded);
+
+  // Create from a JwkSet message. Its keys are checked like those of a JWKS
+  // and built from their raw bytes, without any JSON or base64 decoding.
+  // Like keys in a JWKS, invalid keys are skipped.
+  static std::unique_ptr<Jwks> createFromProto(const JwkSet& jwk_set);
+
   // Adds a key to this keyset.
   Status addKeyFromPem(const std::string& pkey, const std::string& kid,
                        const std::string& alg);
 
   // Struct for JSON Web Key
   struct Pubkey {
-    std::string hmac_key_;
+    Pubkey() {}
+    ~Pubkey();
+    Pubkey(const Pubkey&) = delete;
+    Pubkey& operator=(const Pubkey&) = delete;
+
     std::string kid_;
-    std::string kty_;
     std::string alg_;
+    std::string kty_;
     std::string crv_;
-    bssl::UniquePtr<RSA> rsa_;
-    bssl::UniquePtr<EC_KEY> ec_key_;
-    std::string okp_key_raw_;
-    bssl::UniquePtr<BIO> bio_;
+    // The base64url RFC 7638 thumbprint of the key, computed at load. Empty
+    // for "oct" keys.
+    std::string thumbprint_;
+    // The base64url SHA-1 and SHA-256 of the DER certificate of a key loaded
+    // from one, matching the "x5t" and "x5t#S256" header parameters. Empty
+    // for bare keys.
+    std::string x5t_;
+    std::string x5t_s256_;
+    // Only kept for keys from an x509 key map loaded with
+    // LoadOptions::retain_x509.
     bssl::UniquePtr<X509> x509_;
+
+    // Raw fields of a lazily loaded key, kept until it is materialized.
+    struct LazyFields {
+      // "n" and "e" for RSA, "x" and "y" for EC.
+      std::string first;
+      std::string second;
+      // The curve of an EC key.
+      int nid = 0;
+    };
+
+    // The kind of key material a key holds.
+    enum class Material : uint8_t { None, Rsa, EcKey, Raw, Lazy };
+    Material material() const { return material_; }
+
+    // The key material, or nullptr (empty for raw_key) if the key holds
+    // another kind.
+    RSA* rsa() const { return material_ == Material::Rsa ? key_.rsa : nullptr; }
+    EC_KEY* ec_key() const {
+      return material_ == Material::EcKey ? key_.ec_key : nullptr;
+    }
+    // The secret of an "oct" key, or the public key of an "OKP" key.
+    absl::string_view raw_key() const {
+      return material_ == Material::Raw ? absl::string_view(*key_.raw)
+                                        : absl::string_view();
+    }
+    const LazyFields* lazy() const {
+      return material_ == Material::Lazy ? key_.lazy : nullptr;
+    }
+
+    // Replace the key material. A nullptr key leaves the key empty.
+    void setRsa(bssl::UniquePtr<RSA> rsa);
+    void setEcKey(bssl::UniquePtr<EC_KEY> ec_key);
+    void setRawKey(std::string raw_key);
+    void setLazy(std::unique_ptr<LazyFields> lazy);
+
+    // Builds the RSA or EC key of a lazily loaded key from its raw fields.
+    // It returns Status::Ok right away for keys loaded eagerly. It is safe to
+    // call concurrently; the key is built only once and the same status is
+    // returned to every caller.
+    Status materialize();
+
+    // Estimated memory held by this key in bytes.
+    size_t memoryUsage() const;
+
+   private:
+    void resetMaterial();
+
+    Material material_ = Material::None;
+    std::once_flag materialize_once_;
+    Status materialize_status_ = Status::Ok;
+    union {
+      RSA* rsa;
+      EC_KEY* ec_key;
+      std::string* raw;
+      LazyFields* lazy;
+    } key_ = {nullptr};
   };
   typedef std::unique_ptr<Pubkey> PubkeyPtr;
 
   // Access to list of Jwks
   const std::vector<PubkeyPtr>& keys() const { return keys_; }
 
+  // Returns the key whose RFC 7638 thumbprint or certificate thumbprint
+  // (x5t or x5t#S256) is thumbprint, or nullptr if there is none. If several
+  // keys share a thumbprint, the first one is returned.
+  Pubkey* findByThumbprint(absl::string_view thumbprint) const;
+
+  // Estimated memory held by this key set in bytes, e.g. to size caches.
+  size_t memoryUsage() const;
+
  private:
+  // Defined in jwks_directory_lib, which merges the keys of many files.
+  friend std::unique_ptr<Jwks> loadJwksDirectory(
+      const std::string& path, const LoadOptions& options,
+      std::vector<FileStatus>* file_statuses);
+
+  // Builds thumbprint_index_. It is called once keys_ is complete, and again
+  // whenever keys are added.
+  void buildThumbprintIndex();
+
   // Create Jwks
-  void createFromJwksCore(const std::string& pkey_jwks);
+  void createFromJwksCore(absl::string_view pkey_jwks,
+                          const LoadOptions& options);
+  // Reads the "keys" array of a JWKS, adding its valid keys.
+  void readKeys(JsonReader* reader, const LoadOptions& options);
   // Create PEM
-  void createFromPemCore(const std::string& pkey_pem);
+  void createFromPemCore(absl::string_view pkey_pem);
+  // Create from JwkSet
+  void createFromProtoCore(const JwkSet& jwk_set);
 
   // List of Jwks
   std::vector<PubkeyPtr> keys_;
+  // The keys by their thumbprints. The views point to the thumbprint members
+  // of the keys in keys_.
+  absl::flat_hash_map<absl::string_view, Pubkey*> thumbprint_index_;
 };
 
 typedef std::unique_ptr<Jwks> JwksPtr;
@@ -0,0 +1,44 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "jwt_verify_lib/jwks.h"
+
+namespace google {
+namespace jwt_verify {
+
+// Loads all the key files of a directory into one key set. A file named
+// "<kid>.pem" holds one PEM public key, whose kid is the file name without
+// the extension and whose alg is empty. A file ending in ".json" or ".jwks"
+// holds a JWKS or an x509 key map. Other files are ignored.
+//
+// Files are mmapped and parsed in parallel on options.threads threads, then
+// their keys are merged in the order of the file names. The status of each
+// file is stored in file_statuses if it is not null. The key set status is
+// Ok if any key was loaded, JwksFileReadError if the directory can not be
+// read, JwksNoKeys if it has no key files, and otherwise the failure of the
+// first file.
+//
+// It uses POSIX file APIs, so it is in its own library, jwks_directory_lib.
+std::unique_ptr<Jwks> loadJwksDirectory(
+    const std::string& path, const Jwks::LoadOptions& options,
+    std::vector<Jwks::FileStatus>* file_statuses = nullptr);
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,103 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "absl/time/time.h"
+#include "jwt_verify_lib/jwks.h"
+#include "jwt_verify_lib/status.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * Keeps a key set in sync with a key file, using Linux inotify.
+ *
+ * The directory of the file is watched, so that both in-place writes and
+ * files replaced by a rename, such as Kubernetes secret volume updates, are
+ * seen. A burst of changes is reloaded once, after no change for debounce.
+ * The file is parsed on a background thread, and only a key set that loads
+ * with Status::Ok is published; until then jwks() serves the previous one.
+ *
+ * Usage example:
+ *   JwksFileWatcher watcher("/secrets/jwks.json", JwksFileWatcher::Options());
+ *   watcher.start();
+ *   ...
+ *   std::shared_ptr<const Jwks> jwks = watcher.jwks();
+ *   Status status = verifyJwt(jwt, *jwks);
+ */
+class JwksFileWatcher {
+ public:
+  struct Options {
+    // Format of the key file.
+    Jwks::Type type = Jwks::JWKS;
+    Jwks::LoadOptions load_options;
+    // Time without changes to the file before it is reloaded.
+    absl::Duration debounce = absl::Milliseconds(100);
+  };
+
+  JwksFileWatcher(const std::string& path, const Options& options);
+  // Stops the background thread if it is running.
+  ~JwksFileWatcher();
+
+  // Loads the file and starts a background thread that reloads it when it
+  // changes. Returns JwksFileWatchFail if the file can not be watched,
+  // otherwise the status of the first load. The file is watched even if the
+  // first load failed.
+  Status start();
+  // Stops the background thread and waits for it to exit.
+  void stop();
+
+  // Returns the last good key set, or nullptr if none has been loaded yet.
+  std::shared_ptr<const Jwks> jwks() const;
+
+  // The status of the last load.
+  Status lastLoadStatus() const;
+
+  // The number of key sets published so far.
+  uint64_t generation() const;
+
+ private:
+  // Reads, parses and publishes the key file. Called without the lock.
+  Status reload();
+  // Drains the pending inotify events. Returns true if any of them is about
+  // the key file.
+  bool readEvents();
+  void run();
+
+  const std::string path_;
+  const Options options_;
+  // The directory and name of path_.
+  std::string dir_;
+  std::string name_;
+
+  mutable std::mutex mutex_;
+  std::shared_ptr<const Jwks> jwks_;
+  Status last_status_ = Status::Ok;
+  uint64_t generation_ = 0;
+
+  int inotify_fd_ = -1;
+  // A pipe written by stop() to wake up the background thread.
+  int stop_fds_[2] = {-1, -1};
+  std::thread thread_;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
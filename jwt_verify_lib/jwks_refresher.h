@@ -0,0 +1,126 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "jwt_verify_lib/jwks.h"
+#include "jwt_verify_lib/jwt.h"
+#include "jwt_verify_lib/status.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * Keeps a key set fresh by fetching it on jittered intervals.
+ *
+ * The last good key set is served while a refresh is in flight and after a
+ * refresh fails. Failed refreshes are retried with exponential backoff.
+ * A JwksKidAlgMismatch for a kid that is not in the current key set triggers
+ * an early refresh, rate limited by min_unknown_kid_interval.
+ *
+ * Usage example:
+ *   JwksRefresher refresher(fetcher, JwksRefresher::Options());
+ *   refresher.start();
+ *   ...
+ *   std::shared_ptr<const Jwks> jwks = refresher.jwks();
+ *   Status status = verifyJwt(jwt, *jwks);
+ *   refresher.onVerifyStatus(jwt, status);
+ */
+class JwksRefresher {
+ public:
+  // Fetches the key set text. It returns Status::Ok on success, otherwise the
+  // failure reason such as Status::JwksFetchFail.
+  typedef std::function<Status(std::string* jwks_text)> Fetcher;
+
+  struct Options {
+    // Format of the fetched key set.
+    Jwks::Type type = Jwks::JWKS;
+    Jwks::LoadOptions load_options;
+    // Time between successful refreshes.
+    absl::Duration refresh_interval = absl::Minutes(5);
+    // Refresh times are spread by up to this fraction of refresh_interval,
+    // so that many refreshers started together do not fetch together.
+    double jitter = 0.1;
+    // Delay before retrying a failed refresh. It doubles on every failure
+    // up to max_backoff.
+    absl::Duration initial_backoff = absl::Seconds(1);
+    absl::Duration max_backoff = absl::Minutes(5);
+    // Minimum time between early refreshes triggered by unknown kids.
+    absl::Duration min_unknown_kid_interval = absl::Seconds(30);
+    // Source of the current time.
+    std::function<absl::Time()> clock = absl::Now;
+  };
+
+  JwksRefresher(Fetcher fetcher, const Options& options);
+  // Stops the background thread if it is running.
+  ~JwksRefresher();
+
+  // Starts a background thread that refreshes the key set when due. The
+  // first refresh happens right away.
+  void start();
+  // Stops the background thread and waits for it to exit.
+  void stop();
+
+  // Returns the last good key set, or nullptr if none has been loaded yet.
+  std::shared_ptr<const Jwks> jwks() const;
+
+  // Refreshes the key set if a refresh is due. It is called by the
+  // background thread, and can be called directly instead of start().
+  // Returns true if a refresh was run.
+  bool refreshIfDue();
+
+  // Reports the status of verifying a Jwt with jwks(). Returns true if it
+  // scheduled an early refresh.
+  bool onVerifyStatus(const Jwt& jwt, Status status);
+
+  // The status of the last refresh.
+  Status lastRefreshStatus() const;
+
+  // The time of the next scheduled refresh.
+  absl::Time nextRefreshTime() const;
+
+ private:
+  // Fetches, parses and publishes the key set. Called without the lock.
+  Status refresh();
+  absl::Duration jittered(absl::Duration interval);
+  void run();
+
+  const Fetcher fetcher_;
+  const Options options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable wakeup_;
+  std::shared_ptr<const Jwks> jwks_;
+  Status last_status_ = Status::Ok;
+  absl::Time next_refresh_ = absl::InfinitePast();
+  absl::Time last_unknown_kid_refresh_ = absl::InfinitePast();
+  absl::Duration backoff_;
+  bool refreshing_ = false;
+  bool stopping_ = false;
+  std::mt19937 random_;
+  std::thread thread_;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,130 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "jwt_verify_lib/jwks.h"
+#include "jwt_verify_lib/jwt.h"
+#include "jwt_verify_lib/status.h"
+#include "simple_lru_cache/simple_lru_cache_inl.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * A memory-bounded registry of key sets keyed by issuer.
+ *
+ * Key sets are held in an LRU cache whose size is the estimated memory of the
+ * cached key sets. A key set is pinned while a Handle refers to it, so it is
+ * never evicted from under a caller. On a miss, the user-supplied loader is
+ * called outside of the registry lock; concurrent misses for the same issuer
+ * share one load.
+ *
+ * Usage example:
+ *   JwksRegistry registry(loader, 64 * 1024 * 1024);
+ *   JwksRegistry::Handle keys = registry.lookup(jwt);
+ *   if (keys.status() == Status::Ok) {
+ *     status = verifyJwt(jwt, *keys);
+ *   }
+ */
+class JwksRegistry {
+ public:
+  // Loads the key set of an issuer. A nullptr result or a Jwks with a non-Ok
+  // status is a failed load, which is reported to the callers waiting on it
+  // and is not cached.
+  typedef std::function<JwksPtr(const std::string& issuer)> Loader;
+
+  /**
+   * A pinned reference to a cached key set. It must not outlive the registry.
+   */
+  class Handle {
+   public:
+    Handle() {}
+    Handle(Handle&& other);
+    Handle& operator=(Handle&& other);
+    ~Handle();
+
+    // Ok if the key set is available, otherwise the load failure.
+    Status status() const { return status_; }
+
+    const Jwks* get() const { return jwks_; }
+    const Jwks& operator*() const { return *jwks_; }
+    const Jwks* operator->() const { return jwks_; }
+    explicit operator bool() const { return jwks_ != nullptr; }
+
+   private:
+    friend class JwksRegistry;
+    Handle(JwksRegistry* registry, const std::string& issuer, Jwks* jwks)
+        : registry_(registry),
+          issuer_(issuer),
+          jwks_(jwks),
+          status_(Status::Ok) {}
+    explicit Handle(Status status) : status_(status) {}
+
+    void reset();
+
+    JwksRegistry* registry_ = nullptr;
+    std::string issuer_;
+    Jwks* jwks_ = nullptr;
+    Status status_ = Status::JwtUnknownIssuer;
+  };
+
+  // Create a registry holding key sets of up to max_bytes estimated memory.
+  // Pinned key sets are never evicted, so the limit can be exceeded while
+  // they are in use.
+  JwksRegistry(Loader loader, int64_t max_bytes);
+  ~JwksRegistry();
+
+  // Returns the key set of the issuer, loading it on a miss.
+  Handle lookup(const std::string& issuer);
+
+  // Returns the key set of the issuer of a parsed Jwt.
+  Handle lookup(const Jwt& jwt) { return lookup(jwt.iss_); }
+
+  // Drops the key set of the issuer. It is deleted once no Handle uses it.
+  void remove(const std::string& issuer);
+
+  // The estimated memory of the cached key sets in bytes.
+  int64_t size() const;
+
+  // The number of cached key sets.
+  int64_t entries() const;
+
+ private:
+  // A load shared by concurrent misses for the same issuer.
+  struct PendingLoad {
+    bool done = false;
+    int waiters = 0;
+    Status status = Status::Ok;
+    Jwks* jwks = nullptr;
+  };
+
+  void release(const std::string& issuer, Jwks* jwks);
+
+  const Loader loader_;
+  mutable std::mutex mutex_;
+  std::condition_variable load_done_;
+  simple_lru_cache::SimpleLRUCache<std::string, Jwks> cache_;
+  absl::flat_hash_map<std::string, std::shared_ptr<PendingLoad>> pending_;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -14,10 +14,17 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
 #include "google/protobuf/struct.pb.h"
+#include "jwt_verify_lib/claim_path.h"
+#include "jwt_verify_lib/jwt_claims.h"
 #include "jwt_verify_lib/status.h"
 
 namespace google {
@@ -37,21 +44,28 @@ struct Jwt {
   std::string header_str_;
   // header base64_url encoded
   std::string header_str_base64url_;
-  // header in Struct protobuf
-  ::google::protobuf::Struct header_pb_;
 
   // payload string
   std::string payload_str_;
   // payload base64_url encoded
   std::string payload_str_base64url_;
-  // payload in Struct protobuf
-  ::google::protobuf::Struct payload_pb_;
+  // payload claims, indexed over payload_str_
+  JwtClaims payload_claims_;
   // signature string
   std::string signature_;
   // alg
   std::string alg_;
   // kid
   std::string kid_;
+  // typ, if it is a string
+  std::string typ_;
+  // x5t, the base64url SHA-1 of the signing certificate
+  std::string x5t_;
+  // x5t#S256, the base64url SHA-256 of the signing certificate
+  std::string x5t_s256_;
+  // RFC 7638 thumbprint of the "jwk" header, if it has one. The key itself
+  // is never used; its thumbprint only selects a key of the Jwks.
+  std::string jwk_thumbprint_;
   // iss
   std::string iss_;
   // audiences
@@ -92,6 +106,55 @@ struct Jwt {
    */
   Status parseFromString(const std::string& jwt);
 
+  /**
+   * The header in Struct protobuf. A flat header is parsed without it, so
+   * it is built on the first call. It is safe to call concurrently, but not
+   * concurrently with parseFromString. It replaces the former public
+   * header_pb_ field.
+   * @return the header.
+   */
+  const ::google::protobuf::Struct& headerPb() const;
+
+  /**
+   * The payload in Struct protobuf. The claims are read from
+   * payload_claims_, so it is built on the first call. Like headerPb(), it
+   * is safe to call concurrently. It replaces the former public payload_pb_
+   * field.
+   * @return the payload.
+   */
+  const ::google::protobuf::Struct& payloadPb() const;
+
+  /**
+   * The payload as it was encoded in the token, to forward it without
+   * encoding it again.
+   * @return a view of payload_str_base64url_.
+   */
+  absl::string_view payloadBase64url() const { return payload_str_base64url_; }
+
+  /**
+   * Appends the value of a claim to out, to forward it: a string as it is,
+   * and any other value as its JSON text in the payload. Nothing is
+   * serialized from a Struct.
+   * @param path the claim.
+   * @param out the buffer to append to.
+   * @return the result of the claim lookup.
+   */
+  StructUtils::FindResult appendClaim(const ClaimPath& path,
+                                      std::string* out) const;
+
+  /**
+   * The value of a claim, as appendClaim() writes it, base64url encoded
+   * without padding. It is encoded once per token, so the filters that
+   * forward the same claim share the work. Like headerPb(), it is safe to
+   * call concurrently.
+   * @param path the claim.
+   * @param encoded set to a view that is valid until the Jwt is parsed
+   * again.
+   * @return the result of the claim lookup.
+   */
+  StructUtils::FindResult claimBase64url(const ClaimPath& path,
+                                         absl::string_view* encoded) const;
+
   /*
    * Verify Jwt time constraint if specified
    * esp: expiration time, nbf: not before time.
@@ -101,6 +164,20 @@ struct Jwt {
    */
   Status verifyTimeConstraint(uint64_t now,
                               uint64_t clock_skew = kClockSkewInSecond) const;
+
+ private:
+  // Guards the members built on demand by const accessors.
+  mutable std::mutex lazy_mutex_;
+  // header in Struct protobuf, see headerPb().
+  mutable ::google::protobuf::Struct header_pb_;
+  mutable std::atomic<bool> header_pb_parsed_{false};
+  // payload in Struct protobuf, see payloadPb().
+  mutable ::google::protobuf::Struct payload_pb_;
+  mutable std::atomic<bool> payload_pb_parsed_{false};
+  // claims base64url encoded, by path, see claimBase64url(). Guarded by
+  // lazy_mutex_.
+  mutable absl::flat_hash_map<std::string, std::unique_ptr<std::string>>
+      claims_base64url_;
 };
 
 }  // namespace jwt_verify
@@ -0,0 +1,177 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "jwt_verify_lib/claim_path.h"
+#include "jwt_verify_lib/json_reader.h"
+#include "jwt_verify_lib/struct_utils.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * An index of the members of a JSON object, such as a JWT payload, built in
+ * one pass over its text without building a Struct.
+ *
+ * Each member is recorded with its name and type. String values are decoded
+ * while indexing, and are views of the text unless they have escapes.
+ * Other values are kept as their JSON text: numbers are converted when they
+ * are read, and objects are indexed the first time a nested name reaches
+ * into them.
+ *
+ * The accessors behave like the StructUtils ones on the same object: names
+ * may be nested with dots, e.g. "a.b", and they return the same FindResult.
+ *
+ * The index refers to the text, which must outlive it. Nested objects, and
+ * the sets of Contains(), are built on demand under a lock, so the
+ * accessors may be called concurrently, but not concurrently with parse()
+ * or clear().
+ */
+class JwtClaims {
+ public:
+  using FindResult = StructUtils::FindResult;
+
+  // A member of the object.
+  struct Claim {
+    absl::string_view name;
+    JsonReader::Type type;
+    // A string decoded, or the JSON text of other values.
+    absl::string_view value;
+  };
+
+  JwtClaims() = default;
+  JwtClaims(const JwtClaims&) = delete;
+  JwtClaims& operator=(const JwtClaims&) = delete;
+
+  // Indexes the JSON object in json, replacing the previous index. Returns
+  // false, leaving the index empty, if json is not a valid JSON object.
+  bool parse(absl::string_view json);
+
+  // Empties the index, so that it no longer refers to any text.
+  void clear();
+
+  // The members of the object, in document order.
+  const std::vector<Claim>& claims() const { return claims_; }
+
+  // Each getter takes a nested name, e.g. "a.b", or a ClaimPath built from
+  // one, whose lookups allocate nothing.
+
+  // Gets a string as a view, which is valid as long as the index.
+  FindResult GetString(absl::string_view name,
+                       absl::string_view* str_value) const;
+  FindResult GetString(const ClaimPath& path,
+                       absl::string_view* str_value) const;
+  FindResult GetString(absl::string_view name, std::string* str_value) const;
+  FindResult GetString(const ClaimPath& path, std::string* str_value) const;
+
+  // Return error if the JSON value is not within a positive 64 bit integer
+  // range. The decimals in the JSON value are dropped. Unlike StructUtils,
+  // the value is read exactly from the JSON text, also above 2^53.
+  FindResult GetUInt64(absl::string_view name, uint64_t* int_value) const;
+  FindResult GetUInt64(const ClaimPath& path, uint64_t* int_value) const;
+
+  // Like GetUInt64, for a signed 64 bit integer.
+  FindResult GetInt64(absl::string_view name, int64_t* int_value) const;
+  FindResult GetInt64(const ClaimPath& path, int64_t* int_value) const;
+
+  FindResult GetDouble(absl::string_view name, double* double_value) const;
+  FindResult GetDouble(const ClaimPath& path, double* double_value) const;
+
+  FindResult GetBoolean(absl::string_view name, bool* bool_value) const;
+  FindResult GetBoolean(const ClaimPath& path, bool* bool_value) const;
+
+  // Get string or list of string, designed to get "aud" field.
+  FindResult GetStringList(absl::string_view name,
+                           std::vector<std::string>* list) const;
+  FindResult GetStringList(const ClaimPath& path,
+                           std::vector<std::string>* list) const;
+
+  // Checks if a string or list of string claim, such as "groups", has
+  // value. The claim is hashed into a set on the first call, so that later
+  // calls for the same claim take constant time and copy nothing.
+  FindResult Contains(absl::string_view name, absl::string_view value,
+                      bool* contained) const;
+  FindResult Contains(const ClaimPath& path, absl::string_view value,
+                      bool* contained) const;
+
+  // Find the claim with nested names.
+  FindResult GetValue(absl::string_view nested_names,
+                      const Claim*& found) const;
+  FindResult GetValue(const ClaimPath& path, const Claim*& found) const;
+
+  // Find an object claim with nested names, indexing it if needed.
+  FindResult GetObject(absl::string_view nested_names,
+                       const JwtClaims*& found) const;
+  FindResult GetObject(const ClaimPath& path, const JwtClaims*& found) const;
+
+  // Convert a claim found by GetValue, as the getters do.
+  static FindResult ToString(const Claim& claim, absl::string_view* str_value);
+  static FindResult ToString(const Claim& claim, std::string* str_value);
+  static FindResult ToUInt64(const Claim& claim, uint64_t* int_value);
+  static FindResult ToInt64(const Claim& claim, int64_t* int_value);
+  static FindResult ToDouble(const Claim& claim, double* double_value);
+  static FindResult ToBoolean(const Claim& claim, bool* bool_value);
+  static FindResult ToStringList(const Claim& claim,
+                                 std::vector<std::string>* list);
+  // Gets the index of an object claim of this index, building it if needed.
+  FindResult ToObject(const Claim& claim, const JwtClaims*& found) const;
+
+ private:
+  // The strings of a claim, for Contains().
+  struct StringSet {
+    // The result of ToStringList on the claim.
+    FindResult result = StructUtils::OK;
+    absl::flat_hash_set<absl::string_view> values;
+    // Storage of the strings that had escapes.
+    std::deque<std::string> decoded;
+  };
+
+  // Finds the claim at the nested names, as the member index of owner.
+  template <typename Names>
+  FindResult lookup(const Names& names, const JwtClaims** owner,
+                    size_t* index) const;
+  template <typename Names>
+  FindResult lookupObject(const Names& names, const JwtClaims*& found) const;
+  template <typename Names>
+  FindResult lookupContains(const Names& names, absl::string_view value,
+                            bool* contained) const;
+  // Returns the index of the object member at index i.
+  const JwtClaims& nested(size_t i) const;
+  // Returns the set of strings of the member at index i.
+  const StringSet& stringSet(size_t i) const;
+
+  std::vector<Claim> claims_;
+  // Storage of names and strings that had escapes.
+  std::deque<std::string> decoded_;
+  // Guards nested_ and string_sets_. What they point to is not changed once
+  // built, so it is read without the lock.
+  mutable std::mutex mutex_;
+  // The indexes of object members, by member index, built on demand.
+  mutable std::vector<std::unique_ptr<JwtClaims>> nested_;
+  // The sets of string members, by member index, built on demand.
+  mutable std::vector<std::unique_ptr<StringSet>> string_sets_;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
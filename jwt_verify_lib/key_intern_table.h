@@ -0,0 +1,97 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+
+#include "openssl/bn.h"
+#include "openssl/ec.h"
+#include "openssl/rsa.h"
+#include "simple_lru_cache/simple_lru_cache_inl.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * A process-wide table that shares identical public keys across Jwks
+ * instances.
+ *
+ * Keys are looked up by a SHA-256 thumbprint of their key material. RSA and
+ * EC_KEY objects are reference counted, so every Jwks holding the same key
+ * refers to one object, and the per-key precomputation OpenSSL caches in it
+ * is done only once. The table holds one reference to each key and evicts
+ * the least recently used ones beyond its size; evicted keys stay alive for
+ * as long as a Jwks uses them.
+ *
+ * Interning is disabled until setMaxEntries() is called with a non-zero size.
+ *
+ * Usage example:
+ *   KeyInternTable::global().setMaxEntries(10000);
+ */
+class KeyInternTable {
+ public:
+  // The table used by the Jwks key loaders.
+  static KeyInternTable& global();
+
+  KeyInternTable();
+  ~KeyInternTable();
+
+  // Bounds the table to max_entries keys. 0 disables interning and drops all
+  // the entries.
+  void setMaxEntries(int64_t max_entries);
+  bool enabled() const;
+  // The number of interned keys.
+  int64_t entries() const;
+
+  // The thumbprint RSA keys are interned by, a SHA-256 of (n, e).
+  static std::string rsaThumbprint(const BIGNUM* n, const BIGNUM* e);
+
+  // Returns a new reference to the interned RSA key with the given
+  // thumbprint, or nullptr if there is none or it was interned without
+  // passing RSA_check_key, e.g. from a PEM key or a certificate.
+  bssl::UniquePtr<RSA> findCheckedRsa(const std::string& thumbprint);
+  // Returns a new reference to the interned EC key with the given material,
+  // or nullptr if there is none.
+  bssl::UniquePtr<EC_KEY> findEcKey(int nid, const BIGNUM* x, const BIGNUM* y);
+
+  // Returns the interned key equal to the given one, interning it first if
+  // there is none. The given key is returned as is when interning is
+  // disabled.
+  bssl::UniquePtr<RSA> intern(bssl::UniquePtr<RSA> rsa);
+  bssl::UniquePtr<EC_KEY> intern(bssl::UniquePtr<EC_KEY> ec_key);
+  // Same, for an RSA key with the given thumbprint that passed
+  // RSA_check_key, which marks the interned key as checked.
+  bssl::UniquePtr<RSA> internChecked(bssl::UniquePtr<RSA> rsa,
+                                     const std::string& thumbprint);
+
+ private:
+  struct InternedKey {
+    bssl::UniquePtr<RSA> rsa;
+    // Whether the RSA key passed RSA_check_key.
+    bool rsa_checked = false;
+    bssl::UniquePtr<EC_KEY> ec_key;
+  };
+
+  bssl::UniquePtr<RSA> internRsa(bssl::UniquePtr<RSA> rsa,
+                                 const std::string& thumbprint, bool checked);
+
+  mutable std::mutex mutex_;
+  int64_t max_entries_ = 0;
+  simple_lru_cache::SimpleLRUCache<std::string, InternedKey> cache_;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,107 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "jwt_verify_lib/claim_path.h"
+#include "jwt_verify_lib/jwt_claims.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * Matches the scopes of a token against a vocabulary of known scopes.
+ *
+ * The vocabulary is given once, and each of its scopes is given a bit. The
+ * scope claim of a token, a space delimited string such as "read write",
+ * is read into a bitset in one scan, so that checking if it has all or any
+ * of a set of scopes is a few bitwise operations. Scopes that are not in
+ * the vocabulary are only counted.
+ *
+ * A matcher is immutable and may be shared by threads.
+ *
+ * Usage example:
+ *   static const ScopeMatcher* matcher =
+ *       new ScopeMatcher({"read", "write", "admin"});
+ *   static const ScopeMatcher::Scopes required =
+ *       matcher->compile({"read", "write"});
+ *
+ *   ScopeMatcher::Scopes scopes;
+ *   if (matcher->match(jwt.payload_claims_, &scopes) == StructUtils::OK &&
+ *       scopes.hasAll(required)) { ... }
+ */
+class ScopeMatcher {
+ public:
+  // A set of scopes of the vocabulary, as a bitset.
+  class Scopes {
+   public:
+    // Whether the scope at index i of the vocabulary is in the set.
+    bool has(size_t i) const {
+      return i / 64 < words_.size() && (words_[i / 64] >> (i % 64) & 1);
+    }
+    // Whether every scope of required is in the set.
+    bool hasAll(const Scopes& required) const;
+    // Whether any scope of wanted is in the set.
+    bool hasAny(const Scopes& wanted) const;
+    // The number of scopes read that are not in the vocabulary.
+    size_t unknown() const { return unknown_; }
+
+   private:
+    friend class ScopeMatcher;
+
+    std::vector<uint64_t> words_;
+    size_t unknown_ = 0;
+  };
+
+  // Builds a matcher of the scopes in vocabulary, read from the claim at
+  // nested_names.
+  explicit ScopeMatcher(const std::vector<std::string>& vocabulary,
+                        absl::string_view nested_names = "scope");
+
+  // The number of scopes in the vocabulary.
+  size_t size() const { return indexes_.size(); }
+
+  // Returns the set of scopes, for hasAll() and hasAny(). Scopes that are
+  // not in the vocabulary are counted in unknown(): no token has them.
+  Scopes compile(const std::vector<std::string>& scopes) const;
+
+  // Reads the space delimited scopes of scope into scopes. The words of
+  // scopes are reused, so reusing it for each token does not allocate.
+  void parse(absl::string_view scope, Scopes* scopes) const;
+
+  // Reads the scopes of the scope claim of claims into scopes. The claim
+  // may also be a list of scopes, as some issuers send. Returns MISSING,
+  // with no scopes, if there is no such claim. Like parse(), it allocates
+  // nothing once scopes has grown, unless a scope of a list has escapes.
+  StructUtils::FindResult match(const JwtClaims& claims, Scopes* scopes) const;
+
+ private:
+  // Clears scopes, keeping its words.
+  void reset(Scopes* scopes) const;
+  // Adds a single scope to scopes.
+  void add(absl::string_view scope, Scopes* scopes) const;
+
+  const ClaimPath claim_;
+  // The bit of each scope of the vocabulary.
+  absl::flat_hash_map<std::string, size_t> indexes_;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -219,6 +219,18 @@ enum class Status {
 
   // Failed to create BIO
   JwksBioAllocError,
+
+  // Failed to read a key file or directory
+  JwksFileReadError,
+
+  // "x5t" or "x5t#S256" in the header is not a string.
+  JwtHeaderBadX5t,
+
+  // Jwks is not a valid serialized JwkSet message.
+  JwksProtoParseError,
+
+  // Failed to watch a key file for changes
+  JwksFileWatchFail,
 };
 
 /**
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "google/protobuf/struct.pb.h"
+#include "jwt_verify_lib/claim_path.h"
 
 namespace google {
 namespace jwt_verify {
@@ -30,25 +31,35 @@ class StructUtils {
     OUT_OF_RANGE,
   };
 
+  // Each getter takes a nested name, e.g. "a.b", or a ClaimPath built from
+  // one, whose lookups allocate nothing.
   FindResult GetString(const std::string& name, std::string* str_value);
+  FindResult GetString(const ClaimPath& path, std::string* str_value);
 
   // Return error if the JSON value is not within a positive 64 bit integer
   // range. The decimals in the JSON value are dropped.
   FindResult GetUInt64(const std::string& name, uint64_t* int_value);
+  FindResult GetUInt64(const ClaimPath& path, uint64_t* int_value);
 
   FindResult GetDouble(const std::string& name, double* double_value);
+  FindResult GetDouble(const ClaimPath& path, double* double_value);
 
   FindResult GetBoolean(const std::string& name, bool* bool_value);
+  FindResult GetBoolean(const ClaimPath& path, bool* bool_value);
 
   // Get string or list of string, designed to get "aud" field
   // "aud" can be either string array or string.
   // Try as string array, read it as empty array if doesn't exist.
   FindResult GetStringList(const std::string& name,
                            std::vector<std::string>* list);
+  FindResult GetStringList(const ClaimPath& path,
+                           std::vector<std::string>* list);
 
   // Find the value with nested names.
   FindResult GetValue(const std::string& nested_names,
                       const google::protobuf::Value*& found);
+  FindResult GetValue(const ClaimPath& path,
+                      const google::protobuf::Value*& found);
 
  private:
   const ::google::protobuf::Struct& struct_pb_;
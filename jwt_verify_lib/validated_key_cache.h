@@ -0,0 +1,78 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+
+#include "openssl/bn.h"
+#include "simple_lru_cache/simple_lru_cache_inl.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * A process-wide, bounded set of RSA public keys that passed RSA_check_key.
+ *
+ * Keys are remembered by a SHA-256 fingerprint of (n, e). Loading a JWKS
+ * skips RSA_check_key for keys whose fingerprint is in the set, so key sets
+ * that are refreshed over and over only validate each key once. The least
+ * recently seen fingerprints are evicted beyond the size of the set.
+ *
+ * The global set is disabled until setMaxEntries() is called with a non-zero
+ * size; while it is, loaders do not fingerprint keys for it. It pays off
+ * where RSA_check_key is costly compared to hashing the key;
+ * test/benchmark/jwks_refresh_benchmark measures both.
+ *
+ * Usage example:
+ *   ValidatedKeyCache::global().setMaxEntries(100000);
+ */
+class ValidatedKeyCache {
+ public:
+  // The set used by the Jwks key loaders.
+  static ValidatedKeyCache& global();
+
+  explicit ValidatedKeyCache(int64_t max_entries);
+  ~ValidatedKeyCache();
+
+  // Bounds the set to max_entries keys. 0 disables it and drops all the
+  // entries.
+  void setMaxEntries(int64_t max_entries);
+  bool enabled() const;
+  // The number of remembered keys.
+  int64_t entries() const;
+
+  // The fingerprint of an RSA public key. It is the thumbprint of the key in
+  // KeyInternTable, so the loaders hash each key once for both.
+  static std::string fingerprint(const BIGNUM* n, const BIGNUM* e);
+
+  // Returns true if the key with the given fingerprint passed validation.
+  bool contains(const std::string& fingerprint);
+  // Remembers that the key with the given fingerprint passed validation.
+  void insert(const std::string& fingerprint);
+
+ private:
+  // The cache only needs keys; every entry points to this value.
+  struct Validated {};
+
+  mutable std::mutex mutex_;
+  int64_t max_entries_;
+  simple_lru_cache::SimpleLRUCacheWithDeleter<std::string, Validated,
+                                              void (*)(Validated*)>
+      cache_;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,86 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+
+#include "openssl/rsa.h"
+#include "simple_lru_cache/simple_lru_cache_inl.h"
+
+namespace google {
+namespace jwt_verify {
+
+/**
+ * A process-wide cache of the public keys extracted from x509 certificates.
+ *
+ * x509 key maps are refetched often while the certificates in them rarely
+ * change. The cache maps a SHA-256 fingerprint of a PEM certificate to what
+ * was extracted from it, so unchanged certificates skip the PEM and ASN.1
+ * parsing on every refresh. The least recently used keys are evicted
+ * beyond the size of the cache.
+ *
+ * The global cache is disabled until setMaxEntries() is called with a
+ * non-zero size.
+ *
+ * Usage example:
+ *   X509KeyCache::global().setMaxEntries(1000);
+ */
+class X509KeyCache {
+ public:
+  // The cache used by the Jwks x509 loader.
+  static X509KeyCache& global();
+
+  X509KeyCache();
+  ~X509KeyCache();
+
+  // Bounds the cache to max_entries keys. 0 disables it and drops all the
+  // entries.
+  void setMaxEntries(int64_t max_entries);
+  bool enabled() const;
+  // The number of cached keys.
+  int64_t entries() const;
+
+  // The fingerprint of a PEM certificate.
+  static std::string fingerprint(const std::string& cert_pem);
+
+  // What is extracted from a certificate.
+  struct Entry {
+    bssl::UniquePtr<RSA> rsa;
+    // The RFC 7638 thumbprint of the key.
+    std::string jwk_thumbprint;
+    // The "x5t" and "x5t#S256" thumbprints of the certificate.
+    std::string x5t;
+    std::string x5t_s256;
+  };
+
+  // Sets entry to the cached entry of the certificate with the given
+  // fingerprint, with a new reference to its key. Returns false if it is not
+  // cached.
+  bool find(const std::string& fingerprint, Entry* entry);
+  // Caches the entry of the certificate with the given fingerprint.
+  void insert(const std::string& fingerprint, const Entry& entry);
+
+ private:
+  // Copies from to to, with a new reference to the key.
+  static void copy(const Entry& from, Entry* to);
+
+  mutable std::mutex mutex_;
+  int64_t max_entries_ = 0;
+  simple_lru_cache::SimpleLRUCache<std::string, Entry> cache_;
+};
+
+}  // namespace jwt_verify
+}  // namespace google
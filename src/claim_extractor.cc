@@ -0,0 +1,118 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/claim_extractor.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+void convert(const JwtClaims::Claim& claim, ClaimExtractor::Type type,
+             ClaimExtractor::Result* result) {
+  result->claim = &claim;
+  switch (type) {
+    case ClaimExtractor::Type::Claim:
+      result->code = StructUtils::OK;
+      break;
+    case ClaimExtractor::Type::String:
+      result->code = JwtClaims::ToString(claim, &result->string_value);
+      break;
+    case ClaimExtractor::Type::UInt64:
+      result->code = JwtClaims::ToUInt64(claim, &result->uint64_value);
+      break;
+    case ClaimExtractor::Type::Int64:
+      result->code = JwtClaims::ToInt64(claim, &result->int64_value);
+      break;
+    case ClaimExtractor::Type::Double:
+      result->code = JwtClaims::ToDouble(claim, &result->double_value);
+      break;
+    case ClaimExtractor::Type::Boolean:
+      result->code = JwtClaims::ToBoolean(claim, &result->bool_value);
+      break;
+    case ClaimExtractor::Type::StringList:
+      result->code = JwtClaims::ToStringList(claim, &result->string_list);
+      break;
+  }
+}
+
+}  // namespace
+
+ClaimExtractor::ClaimExtractor(const std::vector<Spec>& specs)
+    : specs_(specs), nodes_(1) {
+  for (size_t i = 0; i < specs_.size(); ++i) {
+    size_t node = 0;
+    for (const std::string& name : specs_[i].path.names()) {
+      auto it = nodes_[node].children.find(name);
+      if (it == nodes_[node].children.end()) {
+        // Add the node before taking a reference into nodes_.
+        nodes_.emplace_back();
+        it = nodes_[node].children.emplace(name, nodes_.size() - 1).first;
+      }
+      node = it->second;
+    }
+    nodes_[node].specs.push_back(i);
+  }
+}
+
+void ClaimExtractor::extract(const JwtClaims& claims, Result* results) const {
+  for (size_t i = 0; i < specs_.size(); ++i) {
+    Result& result = results[i];
+    result.code = StructUtils::MISSING;
+    result.claim = nullptr;
+    result.string_value = absl::string_view();
+    result.uint64_value = 0;
+    result.int64_value = 0;
+    result.double_value = 0;
+    result.bool_value = false;
+    // Keep the capacity for the next token.
+    result.string_list.clear();
+  }
+  walk(0, claims, results);
+}
+
+void ClaimExtractor::walk(size_t node, const JwtClaims& claims,
+                          Result* results) const {
+  const auto& children = nodes_[node].children;
+  for (const JwtClaims::Claim& claim : claims.claims()) {
+    const auto it = children.find(claim.name);
+    if (it == children.end()) {
+      continue;
+    }
+    const Node& child = nodes_[it->second];
+    for (size_t spec : child.specs) {
+      convert(claim, specs_[spec].type, &results[spec]);
+    }
+    if (child.children.empty()) {
+      continue;
+    }
+    const JwtClaims* nested;
+    if (claims.ToObject(claim, nested) == StructUtils::OK) {
+      walk(it->second, *nested, results);
+    } else {
+      failBelow(it->second, results);
+    }
+  }
+}
+
+void ClaimExtractor::failBelow(size_t node, Result* results) const {
+  for (const auto& child : nodes_[node].children) {
+    for (size_t spec : nodes_[child.second].specs) {
+      results[spec].code = StructUtils::WRONG_TYPE;
+    }
+    failBelow(child.second, results);
+  }
+}
+
+}  // namespace jwt_verify
+}  // namespace google
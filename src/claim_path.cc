@@ -0,0 +1,26 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/claim_path.h"
+
+#include "absl/strings/str_split.h"
+
+namespace google {
+namespace jwt_verify {
+
+ClaimPath::ClaimPath(absl::string_view nested_names)
+    : path_(nested_names), names_(absl::StrSplit(nested_names, '.')) {}
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,141 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/claim_policy.h"
+
+#include <algorithm>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/match.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+// Up to this many values, a scan is faster than hashing the claim.
+constexpr size_t kMaxScannedValues = 4;
+
+}  // namespace
+
+ClaimPolicy::ClaimPolicy(const std::vector<Rule>& rules) : rules_(rules) {
+  for (const Rule& rule : rules_) {
+    constants_.insert(constants_.end(), rule.values.begin(), rule.values.end());
+  }
+  std::sort(constants_.begin(), constants_.end());
+  constants_.erase(std::unique(constants_.begin(), constants_.end()),
+                   constants_.end());
+
+  absl::flat_hash_map<absl::string_view, size_t> claim_indexes;
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    const Rule& rule = rules_[i];
+    const auto claim =
+        claim_indexes.emplace(rule.claim, claim_indexes.size()).first;
+    if (claim->second == claims_.size()) {
+      claims_.emplace_back(rule.claim);
+    }
+
+    plan_.emplace_back();
+    Step& step = plan_.back();
+    step.rule = i;
+    step.claim = claim->second;
+    step.op = rule.op;
+    for (const std::string& value : rule.values) {
+      const absl::string_view constant =
+          *std::lower_bound(constants_.begin(), constants_.end(), value);
+      if (std::find(step.values.begin(), step.values.end(), constant) ==
+          step.values.end()) {
+        step.values.push_back(constant);
+      }
+    }
+    if (step.values.size() > kMaxScannedValues) {
+      step.value_set.insert(step.values.begin(), step.values.end());
+    }
+  }
+  // Cheap ops first, keeping the order of the rules otherwise.
+  std::stable_sort(plan_.begin(), plan_.end(),
+                   [](const Step& a, const Step& b) { return a.op < b.op; });
+}
+
+bool ClaimPolicy::isValue(const Step& step, absl::string_view value) {
+  if (!step.value_set.empty()) {
+    return step.value_set.contains(value);
+  }
+  return std::find(step.values.begin(), step.values.end(), value) !=
+         step.values.end();
+}
+
+bool ClaimPolicy::check(const Step& step, const JwtClaims::Claim& claim,
+                        Lookups* lookups) const {
+  switch (step.op) {
+    case Op::Exists:
+      return true;
+    case Op::Equals:
+      return claim.type == JsonReader::Type::String &&
+             isValue(step, claim.value);
+    case Op::Prefix:
+      return claim.type == JsonReader::Type::String &&
+             std::any_of(step.values.begin(), step.values.end(),
+                         [&claim](absl::string_view prefix) {
+                           return absl::StartsWith(claim.value, prefix);
+                         });
+    case Op::Intersects:
+      break;
+  }
+  if (claim.type == JsonReader::Type::String) {
+    return isValue(step, claim.value);
+  }
+  if (claim.type != JsonReader::Type::Array) {
+    return false;
+  }
+  // Like GetStringList, a list with other types fails.
+  JsonReader reader(claim.value);
+  reader.beginArray();
+  bool found = false;
+  absl::string_view value;
+  while (reader.nextElement()) {
+    if (reader.peek() != JsonReader::Type::String) {
+      return false;
+    }
+    reader.readString(&value, &lookups->buffer_);
+    found = found || isValue(step, value);
+  }
+  return found;
+}
+
+const ClaimPolicy::Rule* ClaimPolicy::evaluate(const JwtClaims& claims,
+                                               Lookups* lookups) const {
+  lookups->lookups_.assign(claims_.size(), Lookups::Lookup());
+  for (const Step& step : plan_) {
+    Lookups::Lookup& lookup = lookups->lookups_[step.claim];
+    if (!lookup.done) {
+      lookup.done = true;
+      const JwtClaims::Claim* claim;
+      if (claims.GetValue(claims_[step.claim], claim) == StructUtils::OK) {
+        lookup.claim = claim;
+      }
+    }
+    if (lookup.claim == nullptr || !check(step, *lookup.claim, lookups)) {
+      return &rules_[step.rule];
+    }
+  }
+  return nullptr;
+}
+
+const ClaimPolicy::Rule* ClaimPolicy::evaluate(const Jwt& jwt,
+                                               Lookups* lookups) const {
+  return evaluate(jwt.payload_claims_, lookups);
+}
+
+}  // namespace jwt_verify
+}  // namespace google
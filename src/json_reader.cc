@@ -0,0 +1,551 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/json_reader.h"
+
+#include <system_error>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/charconv.h"
+#include "absl/strings/match.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+// Deeper documents are rejected, which bounds the recursion of skipValue().
+constexpr size_t kMaxDepth = 100;
+
+bool isValidUtf8(absl::string_view str) {
+  const auto* p = reinterpret_cast<const unsigned char*>(str.data());
+  const auto* end = p + str.size();
+  while (p < end) {
+    if (*p < 0x80) {
+      ++p;
+      continue;
+    }
+    size_t len;
+    uint32_t min;
+    uint32_t code_point;
+    if ((*p & 0xE0) == 0xC0) {
+      len = 2;
+      min = 0x80;
+      code_point = *p & 0x1F;
+    } else if ((*p & 0xF0) == 0xE0) {
+      len = 3;
+      min = 0x800;
+      code_point = *p & 0x0F;
+    } else if ((*p & 0xF8) == 0xF0) {
+      len = 4;
+      min = 0x10000;
+      code_point = *p & 0x07;
+    } else {
+      return false;
+    }
+    if (static_cast<size_t>(end - p) < len) {
+      return false;
+    }
+    for (size_t i = 1; i < len; ++i) {
+      if ((p[i] & 0xC0) != 0x80) {
+        return false;
+      }
+      code_point = (code_point << 6) | (p[i] & 0x3F);
+    }
+    // Reject overlong encodings, surrogates and code points past U+10FFFF.
+    if (code_point < min || code_point > 0x10FFFF ||
+        (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+      return false;
+    }
+    p += len;
+  }
+  return true;
+}
+
+void appendUtf8(uint32_t code_point, std::string* out) {
+  if (code_point < 0x80) {
+    out->push_back(static_cast<char>(code_point));
+  } else if (code_point < 0x800) {
+    out->push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  } else if (code_point < 0x10000) {
+    out->push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  } else {
+    out->push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  }
+}
+
+// Parses the 4 hex digits of a \u escape at the start of str.
+bool parseHex4(absl::string_view str, uint32_t* value) {
+  if (str.size() < 4) {
+    return false;
+  }
+  *value = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    const char c = str[i];
+    uint32_t digit;
+    if (c >= '0' && c <= '9') {
+      digit = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      digit = c - 'A' + 10;
+    } else {
+      return false;
+    }
+    *value = (*value << 4) | digit;
+  }
+  return true;
+}
+
+bool isNameStart(char c) {
+  return absl::ascii_isalpha(c) || c == '_' || c == '$';
+}
+
+bool isNumberChar(char c) {
+  return absl::ascii_isdigit(c) || c == '.' || c == 'e' || c == 'E' ||
+         c == '+' || c == '-';
+}
+
+// Checks the syntax of a number without its sign. Like strtod, it accepts
+// a missing integer or fraction part, e.g. ".5" and "1.", but not a leading
+// zero followed by digits.
+bool isValidNumber(absl::string_view number) {
+  if (number.size() >= 2 && number[0] == '0' &&
+      absl::ascii_isdigit(number[1])) {
+    return false;
+  }
+  size_t i = 0;
+  size_t digits = 0;
+  while (i < number.size() && absl::ascii_isdigit(number[i])) {
+    ++i;
+    ++digits;
+  }
+  if (i < number.size() && number[i] == '.') {
+    ++i;
+    while (i < number.size() && absl::ascii_isdigit(number[i])) {
+      ++i;
+      ++digits;
+    }
+  }
+  if (digits == 0) {
+    return false;
+  }
+  if (i < number.size() && (number[i] == 'e' || number[i] == 'E')) {
+    ++i;
+    if (i < number.size() && (number[i] == '+' || number[i] == '-')) {
+      ++i;
+    }
+    size_t exponent_digits = 0;
+    while (i < number.size() && absl::ascii_isdigit(number[i])) {
+      ++i;
+      ++exponent_digits;
+    }
+    if (exponent_digits == 0) {
+      return false;
+    }
+  }
+  return i == number.size();
+}
+
+}  // namespace
+
+JsonReader::JsonReader(absl::string_view json) : json_(json) {}
+
+bool JsonReader::fail() {
+  failed_ = true;
+  return false;
+}
+
+void JsonReader::skipWhitespace() {
+  while (pos_ < json_.size() && absl::ascii_isspace(json_[pos_])) {
+    ++pos_;
+  }
+}
+
+bool JsonReader::consume(char c) {
+  skipWhitespace();
+  if (pos_ < json_.size() && json_[pos_] == c) {
+    ++pos_;
+    return true;
+  }
+  return false;
+}
+
+JsonReader::Type JsonReader::peek() {
+  if (failed_) {
+    return Type::Invalid;
+  }
+  skipWhitespace();
+  if (pos_ == json_.size()) {
+    return Type::Invalid;
+  }
+  const char c = json_[pos_];
+  switch (c) {
+    case '{':
+      return Type::Object;
+    case '[':
+      return Type::Array;
+    case '"':
+    case '\'':
+      return Type::String;
+    case 't':
+    case 'f':
+      return Type::Bool;
+    case 'n':
+      return Type::Null;
+    default:
+      return c == '-' || absl::ascii_isdigit(c) ? Type::Number : Type::Invalid;
+  }
+}
+
+bool JsonReader::scanLiteral(absl::string_view literal) {
+  if (!absl::StartsWith(json_.substr(pos_), literal)) {
+    return fail();
+  }
+  pos_ += literal.size();
+  at_start_ = false;
+  return true;
+}
+
+bool JsonReader::readNull() {
+  return peek() == Type::Null ? scanLiteral("null") : fail();
+}
+
+bool JsonReader::readBool(bool* value) {
+  if (peek() != Type::Bool) {
+    return fail();
+  }
+  *value = json_[pos_] == 't';
+  return scanLiteral(*value ? "true" : "false");
+}
+
+bool JsonReader::scanNumber(absl::string_view* text, double* value) {
+  const size_t start = pos_;
+  size_t end = pos_;
+  if (json_[end] == '-') {
+    ++end;
+  }
+  const size_t unsigned_start = end;
+  while (end < json_.size() && isNumberChar(json_[end])) {
+    ++end;
+  }
+  if (!isValidNumber(json_.substr(unsigned_start, end - unsigned_start))) {
+    return fail();
+  }
+  double parsed;
+  const auto result =
+      absl::from_chars(json_.data() + start, json_.data() + end, parsed);
+  // Underflows are rounded to zero, but overflows are rejected.
+  if (result.ptr != json_.data() + end ||
+      (result.ec == std::errc::result_out_of_range && parsed != 0)) {
+    return fail();
+  }
+  pos_ = end;
+  at_start_ = false;
+  if (text != nullptr) {
+    *text = json_.substr(start, end - start);
+  }
+  if (value != nullptr) {
+    *value = result.ec == std::errc::result_out_of_range ? 0 : parsed;
+  }
+  return true;
+}
+
+bool JsonReader::readNumber(absl::string_view* text) {
+  return peek() == Type::Number ? scanNumber(text, nullptr) : fail();
+}
+
+bool JsonReader::readNumber(double* value) {
+  return peek() == Type::Number ? scanNumber(nullptr, value) : fail();
+}
+
+bool JsonReader::scanString(absl::string_view* value, std::string* buffer) {
+  const char quote = json_[pos_];
+  const size_t start = pos_ + 1;
+  size_t i = start;
+  while (i < json_.size() && json_[i] != quote && json_[i] != '\\') {
+    ++i;
+  }
+  if (i == json_.size()) {
+    return fail();
+  }
+  if (json_[i] == quote) {
+    // No escapes, the string is a view of the input.
+    const absl::string_view raw = json_.substr(start, i - start);
+    if (!isValidUtf8(raw)) {
+      return fail();
+    }
+    pos_ = i + 1;
+    at_start_ = false;
+    *value = raw;
+    return true;
+  }
+
+  buffer->assign(json_.data() + start, i - start);
+  while (true) {
+    if (i == json_.size()) {
+      return fail();
+    }
+    const char c = json_[i++];
+    if (c == quote) {
+      break;
+    }
+    if (c != '\\') {
+      buffer->push_back(c);
+      continue;
+    }
+    if (i == json_.size()) {
+      return fail();
+    }
+    const char escape = json_[i++];
+    switch (escape) {
+      case 'b':
+        buffer->push_back('\b');
+        break;
+      case 'f':
+        buffer->push_back('\f');
+        break;
+      case 'n':
+        buffer->push_back('\n');
+        break;
+      case 'r':
+        buffer->push_back('\r');
+        break;
+      case 't':
+        buffer->push_back('\t');
+        break;
+      case 'u': {
+        uint32_t code_point;
+        if (!parseHex4(json_.substr(i), &code_point)) {
+          return fail();
+        }
+        i += 4;
+        if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+          return fail();
+        }
+        if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+          // A high surrogate must be followed by a low one.
+          uint32_t low;
+          if (json_.substr(i, 2) != "\\u" ||
+              !parseHex4(json_.substr(i + 2), &low) || low < 0xDC00 ||
+              low > 0xDFFF) {
+            return fail();
+          }
+          i += 6;
+          code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+        }
+        appendUtf8(code_point, buffer);
+        break;
+      }
+      default:
+        // Like protobuf's parser, other escaped characters stand for
+        // themselves, including '"', '\'', '\\' and '/'.
+        buffer->push_back(escape);
+        break;
+    }
+  }
+  if (!isValidUtf8(*buffer)) {
+    return fail();
+  }
+  pos_ = i;
+  at_start_ = false;
+  *value = *buffer;
+  return true;
+}
+
+bool JsonReader::readString(std::string* value) {
+  absl::string_view view;
+  if (peek() != Type::String || !scanString(&view, value)) {
+    return fail();
+  }
+  if (view.data() != value->data()) {
+    value->assign(view.data(), view.size());
+  }
+  return true;
+}
+
+bool JsonReader::readString(absl::string_view* value, std::string* buffer) {
+  return peek() == Type::String ? scanString(value, buffer) : fail();
+}
+
+bool JsonReader::skipValue() {
+  absl::string_view unused;
+  switch (peek()) {
+    case Type::Null:
+      return readNull();
+    case Type::Bool:
+      return scanLiteral(json_[pos_] == 't' ? "true" : "false");
+    case Type::Number:
+      return scanNumber(nullptr, nullptr);
+    case Type::String:
+      return scanString(&unused, &scratch_);
+    case Type::Object:
+      if (!beginObject()) {
+        return false;
+      }
+      while (nextMember(&unused)) {
+        if (!skipValue()) {
+          return false;
+        }
+      }
+      return !failed_;
+    case Type::Array:
+      if (!beginArray()) {
+        return false;
+      }
+      while (nextElement()) {
+        if (!skipValue()) {
+          return false;
+        }
+      }
+      return !failed_;
+    case Type::Invalid:
+      break;
+  }
+  return fail();
+}
+
+bool JsonReader::enter() {
+  if (depth_ == kMaxDepth) {
+    return fail();
+  }
+  ++pos_;
+  ++depth_;
+  at_start_ = true;
+  return true;
+}
+
+void JsonReader::leave() {
+  --depth_;
+  at_start_ = false;
+}
+
+bool JsonReader::beginObject() {
+  if (peek() != Type::Object || !enter()) {
+    return fail();
+  }
+  if (names_.size() < depth_) {
+    names_.resize(depth_);
+  }
+  names_[depth_ - 1].clear();
+  return true;
+}
+
+bool JsonReader::beginArray() {
+  return peek() == Type::Array && enter() ? true : fail();
+}
+
+bool JsonReader::scanName(absl::string_view* name) {
+  skipWhitespace();
+  if (pos_ == json_.size()) {
+    return fail();
+  }
+  const char c = json_[pos_];
+  if (c == '"' || c == '\'') {
+    std::string buffer;
+    if (!scanString(name, &buffer)) {
+      return false;
+    }
+    if (name->data() == buffer.data()) {
+      // Keep names with escapes alive as long as the reader.
+      if (decoded_names_ == nullptr) {
+        decoded_names_.reset(new std::deque<std::string>());
+      }
+      decoded_names_->push_back(std::move(buffer));
+      *name = decoded_names_->back();
+    }
+    return true;
+  }
+  // An unquoted name. Like protobuf's parser, it may not be a literal.
+  if (!isNameStart(c)) {
+    return fail();
+  }
+  size_t end = pos_ + 1;
+  while (end < json_.size() &&
+         (isNameStart(json_[end]) || absl::ascii_isdigit(json_[end]))) {
+    ++end;
+  }
+  *name = json_.substr(pos_, end - pos_);
+  if (*name == "true" || *name == "false" || *name == "null") {
+    return fail();
+  }
+  pos_ = end;
+  return true;
+}
+
+bool JsonReader::nextMember(absl::string_view* name) {
+  if (failed_) {
+    return false;
+  }
+  const bool first = at_start_;
+  if (consume('}')) {
+    leave();
+    return false;
+  }
+  if (!first) {
+    if (!consume(',')) {
+      return fail();
+    }
+    // A trailing comma.
+    if (consume('}')) {
+      leave();
+      return false;
+    }
+  }
+  if (!scanName(name) || !consume(':')) {
+    return fail();
+  }
+  if (!names_[depth_ - 1].insert(*name).second) {
+    // Duplicate member name.
+    return fail();
+  }
+  at_start_ = false;
+  return true;
+}
+
+bool JsonReader::nextElement() {
+  if (failed_) {
+    return false;
+  }
+  const bool first = at_start_;
+  if (consume(']')) {
+    leave();
+    return false;
+  }
+  if (!first) {
+    if (!consume(',')) {
+      return fail();
+    }
+    // A trailing comma.
+    if (consume(']')) {
+      leave();
+      return false;
+    }
+  }
+  at_start_ = false;
+  return true;
+}
+
+bool JsonReader::done() {
+  skipWhitespace();
+  return !failed_ && depth_ == 0 && pos_ > 0 && pos_ == json_.size();
+}
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -16,17 +16,24 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
+#include "absl/strings/ascii.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/match.h"
-#include "google/protobuf/struct.pb.h"
-#include "google/protobuf/util/json_util.h"
+#include "absl/strings/str_cat.h"
+#include "jwt_verify_lib/json_reader.h"
+#include "jwt_verify_lib/key_intern_table.h"
 #include "jwt_verify_lib/struct_utils.h"
+#include "jwt_verify_lib/validated_key_cache.h"
+#include "jwt_verify_lib/x509_key_cache.h"
 #include "openssl/bio.h"
 #include "openssl/bn.h"
 #include "openssl/curve25519.h"
 #include "openssl/ecdsa.h"
+#include "openssl/err.h"
 #include "openssl/evp.h"
 #include "openssl/rsa.h"
 #include "openssl/sha.h"
@@ -41,9 +48,149 @@ const char kX509CertPrefix[] = "-----BEGIN CERTIFICATE-----\n";
 // The x509 certificate suffix string
 const char kX509CertSuffix[] = "\n-----END CERTIFICATE-----\n";
 
+// Rough per-object overheads of OpenSSL key objects, on top of the size of
+// their big numbers: the structs themselves, the BIGNUM headers and the
+// Montgomery contexts computed on first use.
+constexpr size_t kRsaOverhead = 512;
+constexpr size_t kEcKeyOverhead = 384;
+constexpr size_t kX509Overhead = 2048;
+
+size_t stringMemory(const std::string& str) {
+  // Short strings are stored inline.
+  return str.capacity() > 15 ? str.capacity() + 1 : 0;
+}
+
 // A convinence inline cast function.
-inline const uint8_t* castToUChar(const std::string& str) {
-  return reinterpret_cast<const uint8_t*>(str.c_str());
+inline const uint8_t* castToUChar(absl::string_view str) {
+  return reinterpret_cast<const uint8_t*>(str.data());
+}
+
+// Base64url encodes the SHA-256 of data.
+std::string base64UrlSha256(absl::string_view data) {
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  SHA256(reinterpret_cast<const uint8_t*>(data.data()), data.size(), digest);
+  return absl::WebSafeBase64Escape(
+      absl::string_view(reinterpret_cast<const char*>(digest), sizeof(digest)));
+}
+
+// Sets the x5t and x5t#S256 thumbprints of a key from the DER encoding of
+// its certificate.
+void setCertThumbprints(absl::string_view der, Jwks::Pubkey* jwk) {
+  uint8_t digest[SHA_DIGEST_LENGTH];
+  SHA1(reinterpret_cast<const uint8_t*>(der.data()), der.size(), digest);
+  jwk->x5t_ = absl::WebSafeBase64Escape(
+      absl::string_view(reinterpret_cast<const char*>(digest), sizeof(digest)));
+  jwk->x5t_s256_ = base64UrlSha256(der);
+}
+
+// Base64url encodes a big number, left padded with zeros to len bytes.
+std::string base64UrlBigNum(const BIGNUM* bn, size_t len) {
+  std::string bytes(std::max<size_t>(len, BN_num_bytes(bn)), '\0');
+  BN_bn2bin(bn, reinterpret_cast<uint8_t*>(&bytes[0]) + bytes.size() -
+                    BN_num_bytes(bn));
+  return absl::WebSafeBase64Escape(bytes);
+}
+
+// Rewrites a base64url big-endian integer in the canonical form of RFC 7518:
+// without leading zero octets, or left padded with zeros to len octets if
+// len is not 0. Returns false if str is not base64url.
+bool canonicalBase64UrlUInt(absl::string_view str, size_t len,
+                            std::string* out) {
+  std::string bytes;
+  if (!absl::WebSafeBase64Unescape(str, &bytes) || bytes.empty()) {
+    return false;
+  }
+  // Zero keeps one octet.
+  const size_t zeros =
+      std::min(bytes.find_first_not_of('\0'), bytes.size() - 1);
+  bytes.erase(0, zeros);
+  if (bytes.size() < len) {
+    bytes.insert(0, len - bytes.size(), '\0');
+  }
+  absl::WebSafeBase64Escape(bytes, out);
+  return true;
+}
+
+// The size in octets of the coordinates of a curve, or 0 if it is unknown.
+size_t curveCoordinateSize(absl::string_view crv) {
+  if (crv == "P-256") {
+    return 32;
+  }
+  if (crv == "P-384") {
+    return 48;
+  }
+  if (crv == "P-521") {
+    return 66;
+  }
+  return 0;
+}
+
+// Computes the RFC 7638 thumbprint of a key from its key material. Returns
+// empty for key types or curves it does not cover.
+std::string computeJwkThumbprint(const Jwks::Pubkey& jwk) {
+  Jwks::ThumbprintMembers members;
+  std::string first;
+  std::string second;
+  if (jwk.rsa() != nullptr) {
+    first = base64UrlBigNum(RSA_get0_e(jwk.rsa()), 0);
+    second = base64UrlBigNum(RSA_get0_n(jwk.rsa()), 0);
+    members.kty = "RSA";
+    members.e = first;
+    members.n = second;
+  } else if (jwk.ec_key() != nullptr) {
+    const EC_GROUP* group = EC_KEY_get0_group(jwk.ec_key());
+    switch (EC_GROUP_get_curve_name(group)) {
+      case NID_X9_62_prime256v1:
+        members.crv = "P-256";
+        break;
+      case NID_secp384r1:
+        members.crv = "P-384";
+        break;
+      case NID_secp521r1:
+        members.crv = "P-521";
+        break;
+      default:
+        return "";
+    }
+    bssl::UniquePtr<BIGNUM> x(BN_new());
+    bssl::UniquePtr<BIGNUM> y(BN_new());
+    if (!EC_POINT_get_affine_coordinates_GFp(
+            group, EC_KEY_get0_public_key(jwk.ec_key()), x.get(), y.get(),
+            nullptr)) {
+      return "";
+    }
+    const size_t len = (EC_GROUP_get_degree(group) + 7) / 8;
+    first = base64UrlBigNum(x.get(), len);
+    second = base64UrlBigNum(y.get(), len);
+    members.kty = "EC";
+    members.x = first;
+    members.y = second;
+  } else if (jwk.kty_ == "OKP") {
+    first = absl::WebSafeBase64Escape(jwk.raw_key());
+    members.kty = "OKP";
+    members.crv = jwk.crv_;
+    members.x = first;
+  } else {
+    return "";
+  }
+  return Jwks::computeThumbprint(members);
+}
+
+// A cheap syntax check of a base64url string for lazily loaded keys: it
+// validates the alphabet and the length without decoding.
+bool isBase64UrlSyntax(absl::string_view str) {
+  while (!str.empty() && str.back() == '=') {
+    str.remove_suffix(1);
+  }
+  if (str.empty() || str.size() % 4 == 1) {
+    return false;
+  }
+  for (char c : str) {
+    if (!absl::ascii_isalnum(c) && c != '-' && c != '_') {
+      return false;
+    }
+  }
+  return true;
 }
 
 /** Class to create key object from string of public key, formatted in PEM
@@ -56,7 +203,7 @@ inline const uint8_t* castToUChar(const std::string& str) {
  */
 class KeyGetter : public WithStatus {
  public:
-  bssl::UniquePtr<EVP_PKEY> createEvpPkeyFromPem(const std::string& pkey_pem) {
+  bssl::UniquePtr<EVP_PKEY> createEvpPkeyFromPem(absl::string_view pkey_pem) {
     bssl::UniquePtr<BIO> buf(BIO_new_mem_buf(pkey_pem.data(), pkey_pem.size()));
     if (buf == nullptr) {
       updateStatus(Status::JwksBioAllocError);
@@ -73,11 +220,6 @@ class KeyGetter : public WithStatus {
 
   bssl::UniquePtr<EC_KEY> createEcKeyFromJwkEC(int nid, const std::string& x,
                                                const std::string& y) {
-    bssl::UniquePtr<EC_KEY> ec_key(EC_KEY_new_by_curve_name(nid));
-    if (!ec_key) {
-      updateStatus(Status::JwksEcCreateKeyFail);
-      return nullptr;
-    }
     bssl::UniquePtr<BIGNUM> bn_x = createBigNumFromBase64UrlString(x);
     bssl::UniquePtr<BIGNUM> bn_y = createBigNumFromBase64UrlString(y);
     if (!bn_x || !bn_y) {
@@ -85,19 +227,78 @@ class KeyGetter : public WithStatus {
       updateStatus(Status::JwksEcXorYBadBase64);
       return nullptr;
     }
+    return createEcKeyFromBigNums(nid, bn_x.get(), bn_y.get());
+  }
 
-    if (EC_KEY_set_public_key_affine_coordinates(ec_key.get(), bn_x.get(),
-                                                 bn_y.get()) == 0) {
+  // Creates an EC key from the big-endian bytes of its coordinates.
+  bssl::UniquePtr<EC_KEY> createEcKeyFromBytes(int nid, absl::string_view x,
+                                               absl::string_view y) {
+    bssl::UniquePtr<BIGNUM> bn_x = createBigNumFromBytes(x);
+    bssl::UniquePtr<BIGNUM> bn_y = createBigNumFromBytes(y);
+    if (!bn_x || !bn_y) {
       updateStatus(Status::JwksEcParseError);
       return nullptr;
     }
-    return ec_key;
+    return createEcKeyFromBigNums(nid, bn_x.get(), bn_y.get());
   }
 
   bssl::UniquePtr<RSA> createRsaFromJwk(const std::string& n,
                                         const std::string& e) {
-    bssl::UniquePtr<BIGNUM> n_bn = createBigNumFromBase64UrlString(n);
-    bssl::UniquePtr<BIGNUM> e_bn = createBigNumFromBase64UrlString(e);
+    return createRsaFromBigNums(createBigNumFromBase64UrlString(n),
+                                createBigNumFromBase64UrlString(e));
+  }
+
+  // Creates an RSA key from the big-endian bytes of n and e.
+  bssl::UniquePtr<RSA> createRsaFromBytes(absl::string_view n,
+                                          absl::string_view e) {
+    return createRsaFromBigNums(createBigNumFromBytes(n),
+                                createBigNumFromBytes(e));
+  }
+
+  std::string createRawKeyFromJwkOKP(int nid, size_t keylen,
+                                     const std::string& x) {
+    std::string x_decoded;
+    if (!absl::WebSafeBase64Unescape(x, &x_decoded)) {
+      updateStatus(Status::JwksOKPXBadBase64);
+    } else if (x_decoded.length() != keylen) {
+      updateStatus(Status::JwksOKPXWrongLength);
+    }
+    // For OKP the "x" value is the public key and can just be used as-is
+    return x_decoded;
+  }
+
+  // Creates an OKP key from the bytes of its "x" value.
+  std::string createRawKeyFromBytesOKP(size_t keylen, absl::string_view x) {
+    if (x.length() != keylen) {
+      updateStatus(Status::JwksOKPXWrongLength);
+    }
+    return std::string(x);
+  }
+
+ private:
+  bssl::UniquePtr<EC_KEY> createEcKeyFromBigNums(int nid, BIGNUM* bn_x,
+                                                 BIGNUM* bn_y) {
+    bssl::UniquePtr<EC_KEY> interned =
+        KeyInternTable::global().findEcKey(nid, bn_x, bn_y);
+    if (interned != nullptr) {
+      return interned;
+    }
+
+    bssl::UniquePtr<EC_KEY> ec_key(EC_KEY_new_by_curve_name(nid));
+    if (!ec_key) {
+      updateStatus(Status::JwksEcCreateKeyFail);
+      return nullptr;
+    }
+    if (EC_KEY_set_public_key_affine_coordinates(ec_key.get(), bn_x, bn_y) ==
+        0) {
+      updateStatus(Status::JwksEcParseError);
+      return nullptr;
+    }
+    return KeyInternTable::global().intern(std::move(ec_key));
+  }
+
+  bssl::UniquePtr<RSA> createRsaFromBigNums(bssl::UniquePtr<BIGNUM> n_bn,
+                                            bssl::UniquePtr<BIGNUM> e_bn) {
     if (n_bn == nullptr || e_bn == nullptr) {
       // RSA public key field is missing or has parse error.
       updateStatus(Status::JwksRsaParseError);
@@ -109,6 +310,24 @@ class KeyGetter : public WithStatus {
       updateStatus(Status::JwksRsaParseError);
       return nullptr;
     }
+    // One digest of n and e serves both caches, and is skipped when neither
+    // is enabled.
+    KeyInternTable& interned_keys = KeyInternTable::global();
+    ValidatedKeyCache& validated = ValidatedKeyCache::global();
+    const bool intern = interned_keys.enabled();
+    const bool remember = validated.enabled();
+    std::string thumbprint;
+    if (intern || remember) {
+      thumbprint = KeyInternTable::rsaThumbprint(n_bn.get(), e_bn.get());
+    }
+    // Only an interned key that passed RSA_check_key may skip it; keys from
+    // PEM keys and certificates are interned unchecked.
+    if (intern) {
+      bssl::UniquePtr<RSA> interned = interned_keys.findCheckedRsa(thumbprint);
+      if (interned != nullptr) {
+        return interned;
+      }
+    }
     // When jwt_verify_lib's minimum supported BoringSSL revision is past
     // https://boringssl-review.googlesource.com/c/boringssl/+/59386 (May 2023),
     // replace all this with `RSA_new_public_key` instead.
@@ -122,49 +341,193 @@ class KeyGetter : public WithStatus {
     // `RSA_set0_key` takes ownership, but only on success.
     n_bn.release();
     e_bn.release();
-    if (!RSA_check_key(rsa.get())) {
-      // Not a valid RSA public key.
-      updateStatus(Status::JwksRsaParseError);
-      return nullptr;
+    // RSA_check_key only depends on n and e, so a key that passed it before
+    // needs no second check.
+    if (!remember || !validated.contains(thumbprint)) {
+      if (!RSA_check_key(rsa.get())) {
+        // Not a valid RSA public key.
+        updateStatus(Status::JwksRsaParseError);
+        return nullptr;
+      }
+      if (remember) {
+        validated.insert(thumbprint);
+      }
     }
-    return rsa;
-  }
-
-  std::string createRawKeyFromJwkOKP(int nid, size_t keylen,
-                                     const std::string& x) {
-    std::string x_decoded;
-    if (!absl::WebSafeBase64Unescape(x, &x_decoded)) {
-      updateStatus(Status::JwksOKPXBadBase64);
-    } else if (x_decoded.length() != keylen) {
-      updateStatus(Status::JwksOKPXWrongLength);
+    if (!intern) {
+      return rsa;
     }
-    // For OKP the "x" value is the public key and can just be used as-is
-    return x_decoded;
+    return interned_keys.internChecked(std::move(rsa), thumbprint);
   }
 
- private:
   bssl::UniquePtr<BIGNUM> createBigNumFromBase64UrlString(
       const std::string& s) {
     std::string s_decoded;
     if (!absl::WebSafeBase64Unescape(s, &s_decoded)) {
       return nullptr;
     }
-    return bssl::UniquePtr<BIGNUM>(
-        BN_bin2bn(castToUChar(s_decoded), s_decoded.length(), NULL));
+    return createBigNumFromBytes(s_decoded);
   };
+
+  bssl::UniquePtr<BIGNUM> createBigNumFromBytes(absl::string_view bytes) {
+    return bssl::UniquePtr<BIGNUM>(
+        BN_bin2bn(castToUChar(bytes), bytes.length(), nullptr));
+  }
+};
+
+// Checks that alg, if set, is an algorithm for keys of type kty.
+Status checkKeyAlg(absl::string_view kty, const std::string& alg) {
+  if (alg.empty()) {
+    return Status::Ok;
+  }
+  if (kty == "RSA") {
+    if (!absl::StartsWith(alg, "RS") && !absl::StartsWith(alg, "PS")) {
+      return Status::JwksRSAKeyBadAlg;
+    }
+  } else if (kty == "EC") {
+    if (!absl::StartsWith(alg, "ES")) {
+      return Status::JwksECKeyBadAlg;
+    }
+  } else if (kty == "oct") {
+    if (alg != "HS256" && alg != "HS384" && alg != "HS512") {
+      return Status::JwksHMACKeyBadAlg;
+    }
+  } else if (kty == "OKP") {
+    // alg is not required, but if present it must be EdDSA
+    if (alg != "EdDSA") {
+      return Status::JwksOKPKeyBadAlg;
+    }
+  }
+  return Status::Ok;
+}
+
+// Sets the curve of an EC key from its alg and crv, and returns its nid in
+// nid.
+Status resolveEcCurve(absl::string_view crv_str, Jwks::Pubkey* jwk, int* nid) {
+  // If both alg and crv specified, make sure they match
+  if (!jwk->alg_.empty() && !crv_str.empty()) {
+    if (!((jwk->alg_ == "ES256" && crv_str == "P-256") ||
+          (jwk->alg_ == "ES384" && crv_str == "P-384") ||
+          (jwk->alg_ == "ES512" && crv_str == "P-521"))) {
+      return Status::JwksECKeyAlgNotCompatibleWithCrv;
+    }
+  }
+
+  // If neither alg or crv is set, assume P-256
+  if (jwk->alg_.empty() && crv_str.empty()) {
+    crv_str = "P-256";
+  }
+
+  if (jwk->alg_ == "ES256" || crv_str == "P-256") {
+    *nid = NID_X9_62_prime256v1;
+    jwk->crv_ = "P-256";
+  } else if (jwk->alg_ == "ES384" || crv_str == "P-384") {
+    *nid = NID_secp384r1;
+    jwk->crv_ = "P-384";
+  } else if (jwk->alg_ == "ES512" || crv_str == "P-521") {
+    *nid = NID_secp521r1;
+    jwk->crv_ = "P-521";
+  } else {
+    return Status::JwksECKeyAlgOrCrvUnsupported;
+  }
+  return Status::Ok;
+}
+
+// A member of a JWK object, with the code StructUtils::GetString would
+// return for it.
+struct JwkMember {
+  StructUtils::FindResult code = StructUtils::MISSING;
+  std::string value;
 };
 
-Status extractJwkFromJwkRSA(const ::google::protobuf::Struct& jwk_pb,
+// The members of a JWK object that its key is extracted from.
+struct JwkMembers {
+  JwkMember kty;
+  JwkMember kid;
+  JwkMember alg;
+  JwkMember crv;
+  JwkMember n;
+  JwkMember e;
+  JwkMember x;
+  JwkMember y;
+  JwkMember k;
+  // The first certificate of "x5c".
+  JwkMember x5c;
+};
+
+// Moves the value of a string member to value, and returns its code.
+StructUtils::FindResult takeMember(JwkMember* member, std::string* value) {
+  if (member->code == StructUtils::OK) {
+    *value = std::move(member->value);
+  }
+  return member->code;
+}
+
+// Reads a string member, or records that it has another type.
+bool readJwkMember(JsonReader* reader, JwkMember* member) {
+  if (reader->peek() != JsonReader::Type::String) {
+    member->code = StructUtils::WRONG_TYPE;
+    return reader->skipValue();
+  }
+  member->code = StructUtils::OK;
+  return reader->readString(&member->value);
+}
+
+// Reads a JWK object, keeping only the members keys are extracted from.
+bool readJwkMembers(JsonReader* reader, JwkMembers* members) {
+  if (!reader->beginObject()) {
+    return false;
+  }
+  absl::string_view name;
+  while (reader->nextMember(&name)) {
+    JwkMember* member = nullptr;
+    if (name == "kty") {
+      member = &members->kty;
+    } else if (name == "kid") {
+      member = &members->kid;
+    } else if (name == "alg") {
+      member = &members->alg;
+    } else if (name == "crv") {
+      member = &members->crv;
+    } else if (name == "n") {
+      member = &members->n;
+    } else if (name == "e") {
+      member = &members->e;
+    } else if (name == "x") {
+      member = &members->x;
+    } else if (name == "y") {
+      member = &members->y;
+    } else if (name == "k") {
+      member = &members->k;
+    }
+
+    bool ok;
+    if (member != nullptr) {
+      ok = readJwkMember(reader, member);
+    } else if (name == "x5c" && reader->peek() == JsonReader::Type::Array) {
+      ok = reader->beginArray();
+      for (bool first = true; ok && reader->nextElement(); first = false) {
+        ok = first ? readJwkMember(reader, &members->x5c) : reader->skipValue();
+      }
+    } else {
+      ok = reader->skipValue();
+    }
+    if (!ok) {
+      return false;
+    }
+  }
+  return !reader->failed();
+}
+
+Status extractJwkFromJwkRSA(JwkMembers* jwk_members,
+                            const Jwks::LoadOptions& options,
                             Jwks::Pubkey* jwk) {
-  if (!jwk->alg_.empty() &&
-      (jwk->alg_.size() < 2 || (jwk->alg_.compare(0, 2, "RS") != 0 &&
-                                jwk->alg_.compare(0, 2, "PS") != 0))) {
-    return Status::JwksRSAKeyBadAlg;
+  Status status = checkKeyAlg("RSA", jwk->alg_);
+  if (status != Status::Ok) {
+    return status;
   }
 
-  StructUtils jwk_getter(jwk_pb);
   std::string n_str;
-  auto code = jwk_getter.GetString("n", &n_str);
+  auto code = takeMember(&jwk_members->n, &n_str);
   if (code == StructUtils::MISSING) {
     return Status::JwksRSAKeyMissingN;
   }
@@ -173,7 +536,7 @@ Status extractJwkFromJwkRSA(const ::google::protobuf::Struct& jwk_pb,
   }
 
   std::string e_str;
-  code = jwk_getter.GetString("e", &e_str);
+  code = takeMember(&jwk_members->e, &e_str);
   if (code == StructUtils::MISSING) {
     return Status::JwksRSAKeyMissingE;
   }
@@ -181,59 +544,54 @@ Status extractJwkFromJwkRSA(const ::google::protobuf::Struct& jwk_pb,
     return Status::JwksRSAKeyBadE;
   }
 
+  Jwks::ThumbprintMembers members;
+  members.kty = "RSA";
+  members.e = e_str;
+  members.n = n_str;
+  jwk->thumbprint_ = Jwks::computeThumbprint(members);
+
+  if (options.lazy) {
+    if (!isBase64UrlSyntax(n_str) || !isBase64UrlSyntax(e_str)) {
+      return Status::JwksRsaParseError;
+    }
+    std::unique_ptr<Jwks::Pubkey::LazyFields> lazy(
+        new Jwks::Pubkey::LazyFields());
+    lazy->first = std::move(n_str);
+    lazy->second = std::move(e_str);
+    jwk->setLazy(std::move(lazy));
+    return Status::Ok;
+  }
+
   KeyGetter e;
-  jwk->rsa_ = e.createRsaFromJwk(n_str, e_str);
+  jwk->setRsa(e.createRsaFromJwk(n_str, e_str));
   return e.getStatus();
 }
 
-Status extractJwkFromJwkEC(const ::google::protobuf::Struct& jwk_pb,
+Status extractJwkFromJwkEC(JwkMembers* jwk_members,
+                           const Jwks::LoadOptions& options,
                            Jwks::Pubkey* jwk) {
-  if (!jwk->alg_.empty() &&
-      (jwk->alg_.size() < 2 || jwk->alg_.compare(0, 2, "ES") != 0)) {
-    return Status::JwksECKeyBadAlg;
+  Status status = checkKeyAlg("EC", jwk->alg_);
+  if (status != Status::Ok) {
+    return status;
   }
 
-  StructUtils jwk_getter(jwk_pb);
   std::string crv_str;
-  auto code = jwk_getter.GetString("crv", &crv_str);
+  auto code = takeMember(&jwk_members->crv, &crv_str);
   if (code == StructUtils::MISSING) {
     crv_str = "";
   }
   if (code == StructUtils::WRONG_TYPE) {
     return Status::JwksECKeyBadCrv;
   }
-  jwk->crv_ = crv_str;
-
-  // If both alg and crv specified, make sure they match
-  if (!jwk->alg_.empty() && !jwk->crv_.empty()) {
-    if (!((jwk->alg_ == "ES256" && jwk->crv_ == "P-256") ||
-          (jwk->alg_ == "ES384" && jwk->crv_ == "P-384") ||
-          (jwk->alg_ == "ES512" && jwk->crv_ == "P-521"))) {
-      return Status::JwksECKeyAlgNotCompatibleWithCrv;
-    }
-  }
-
-  // If neither alg or crv is set, assume P-256
-  if (jwk->alg_.empty() && jwk->crv_.empty()) {
-    jwk->crv_ = "P-256";
-  }
 
   int nid;
-  if (jwk->alg_ == "ES256" || jwk->crv_ == "P-256") {
-    nid = NID_X9_62_prime256v1;
-    jwk->crv_ = "P-256";
-  } else if (jwk->alg_ == "ES384" || jwk->crv_ == "P-384") {
-    nid = NID_secp384r1;
-    jwk->crv_ = "P-384";
-  } else if (jwk->alg_ == "ES512" || jwk->crv_ == "P-521") {
-    nid = NID_secp521r1;
-    jwk->crv_ = "P-521";
-  } else {
-    return Status::JwksECKeyAlgOrCrvUnsupported;
+  status = resolveEcCurve(crv_str, jwk, &nid);
+  if (status != Status::Ok) {
+    return status;
   }
 
   std::string x_str;
-  code = jwk_getter.GetString("x", &x_str);
+  code = takeMember(&jwk_members->x, &x_str);
   if (code == StructUtils::MISSING) {
     return Status::JwksECKeyMissingX;
   }
@@ -242,7 +600,7 @@ Status extractJwkFromJwkEC(const ::google::protobuf::Struct& jwk_pb,
   }
 
   std::string y_str;
-  code = jwk_getter.GetString("y", &y_str);
+  code = takeMember(&jwk_members->y, &y_str);
   if (code == StructUtils::MISSING) {
     return Status::JwksECKeyMissingY;
   }
@@ -250,21 +608,39 @@ Status extractJwkFromJwkEC(const ::google::protobuf::Struct& jwk_pb,
     return Status::JwksECKeyBadY;
   }
 
+  Jwks::ThumbprintMembers members;
+  members.kty = "EC";
+  members.crv = jwk->crv_;
+  members.x = x_str;
+  members.y = y_str;
+  jwk->thumbprint_ = Jwks::computeThumbprint(members);
+
+  if (options.lazy) {
+    if (!isBase64UrlSyntax(x_str) || !isBase64UrlSyntax(y_str)) {
+      return Status::JwksEcXorYBadBase64;
+    }
+    std::unique_ptr<Jwks::Pubkey::LazyFields> lazy(
+        new Jwks::Pubkey::LazyFields());
+    lazy->first = std::move(x_str);
+    lazy->second = std::move(y_str);
+    lazy->nid = nid;
+    jwk->setLazy(std::move(lazy));
+    return Status::Ok;
+  }
+
   KeyGetter e;
-  jwk->ec_key_ = e.createEcKeyFromJwkEC(nid, x_str, y_str);
+  jwk->setEcKey(e.createEcKeyFromJwkEC(nid, x_str, y_str));
   return e.getStatus();
 }
 
-Status extractJwkFromJwkOct(const ::google::protobuf::Struct& jwk_pb,
-                            Jwks::Pubkey* jwk) {
-  if (!jwk->alg_.empty() && jwk->alg_ != "HS256" && jwk->alg_ != "HS384" &&
-      jwk->alg_ != "HS512") {
-    return Status::JwksHMACKeyBadAlg;
+Status extractJwkFromJwkOct(JwkMembers* jwk_members, Jwks::Pubkey* jwk) {
+  Status status = checkKeyAlg("oct", jwk->alg_);
+  if (status != Status::Ok) {
+    return status;
   }
 
-  StructUtils jwk_getter(jwk_pb);
   std::string k_str;
-  auto code = jwk_getter.GetString("k", &k_str);
+  auto code = takeMember(&jwk_members->k, &k_str);
   if (code == StructUtils::MISSING) {
     return Status::JwksHMACKeyMissingK;
   }
@@ -277,29 +653,26 @@ Status extractJwkFromJwkOct(const ::google::protobuf::Struct& jwk_pb,
     return Status::JwksOctBadBase64;
   }
 
-  jwk->hmac_key_ = key;
+  jwk->setRawKey(std::move(key));
   return Status::Ok;
 }
 
 // The "OKP" key type is defined in https://tools.ietf.org/html/rfc8037
-Status extractJwkFromJwkOKP(const ::google::protobuf::Struct& jwk_pb,
-                            Jwks::Pubkey* jwk) {
-  // alg is not required, but if present it must be EdDSA
-  if (!jwk->alg_.empty() && jwk->alg_ != "EdDSA") {
-    return Status::JwksOKPKeyBadAlg;
+Status extractJwkFromJwkOKP(JwkMembers* jwk_members, Jwks::Pubkey* jwk) {
+  Status status = checkKeyAlg("OKP", jwk->alg_);
+  if (status != Status::Ok) {
+    return status;
   }
 
   // crv is required per https://tools.ietf.org/html/rfc8037#section-2
-  StructUtils jwk_getter(jwk_pb);
   std::string crv_str;
-  auto code = jwk_getter.GetString("crv", &crv_str);
+  auto code = takeMember(&jwk_members->crv, &crv_str);
   if (code == StructUtils::MISSING) {
     return Status::JwksOKPKeyMissingCrv;
   }
   if (code == StructUtils::WRONG_TYPE) {
     return Status::JwksOKPKeyBadCrv;
   }
-  jwk->crv_ = crv_str;
 
   // Valid crv values:
   // https://tools.ietf.org/html/rfc8037#section-3
@@ -310,16 +683,17 @@ Status extractJwkFromJwkOKP(const ::google::protobuf::Struct& jwk_pb,
   // Ed448 and X448: Not implemented in boringssl
   int nid;
   size_t keylen;
-  if (jwk->crv_ == "Ed25519") {
+  if (crv_str == "Ed25519") {
     nid = EVP_PKEY_ED25519;
     keylen = ED25519_PUBLIC_KEY_LEN;
+    jwk->crv_ = "Ed25519";
   } else {
     return Status::JwksOKPKeyCrvUnsupported;
   }
 
   // x is required per https://tools.ietf.org/html/rfc8037#section-2
   std::string x_str;
-  code = jwk_getter.GetString("x", &x_str);
+  code = takeMember(&jwk_members->x, &x_str);
   if (code == StructUtils::MISSING) {
     return Status::JwksOKPKeyMissingX;
   }
@@ -327,16 +701,83 @@ Status extractJwkFromJwkOKP(const ::google::protobuf::Struct& jwk_pb,
     return Status::JwksOKPKeyBadX;
   }
 
+  Jwks::ThumbprintMembers members;
+  members.kty = "OKP";
+  members.crv = jwk->crv_;
+  members.x = x_str;
+  jwk->thumbprint_ = Jwks::computeThumbprint(members);
+
   KeyGetter e;
-  jwk->okp_key_raw_ = e.createRawKeyFromJwkOKP(nid, keylen, x_str);
+  jwk->setRawKey(e.createRawKeyFromJwkOKP(nid, keylen, x_str));
   return e.getStatus();
 }
 
-Status extractJwk(const ::google::protobuf::Struct& jwk_pb, Jwks::Pubkey* jwk) {
-  StructUtils jwk_getter(jwk_pb);
+// Extracts the key of a PEM public key or certificate. RSA and EC keys are
+// interned if intern is true.
+Status extractEvpPkey(EVP_PKEY* evp_pkey, bool intern, Jwks::Pubkey* jwk) {
+  KeyInternTable& table = KeyInternTable::global();
+  switch (EVP_PKEY_id(evp_pkey)) {
+    case EVP_PKEY_RSA: {
+      bssl::UniquePtr<RSA> rsa(EVP_PKEY_get1_RSA(evp_pkey));
+      jwk->setRsa(intern ? table.intern(std::move(rsa)) : std::move(rsa));
+      jwk->kty_ = "RSA";
+      break;
+    }
+    case EVP_PKEY_EC: {
+      bssl::UniquePtr<EC_KEY> ec_key(EVP_PKEY_get1_EC_KEY(evp_pkey));
+      jwk->setEcKey(intern ? table.intern(std::move(ec_key))
+                           : std::move(ec_key));
+      jwk->kty_ = "EC";
+      break;
+    }
+#ifndef BORINGSSL_FIPS
+    case EVP_PKEY_ED25519: {
+      uint8_t raw_key[ED25519_PUBLIC_KEY_LEN];
+      size_t out_len = ED25519_PUBLIC_KEY_LEN;
+      if (EVP_PKEY_get_raw_public_key(evp_pkey, raw_key, &out_len) != 1 ||
+          out_len != ED25519_PUBLIC_KEY_LEN) {
+        return Status::JwksPemGetRawEd25519Error;
+      }
+      jwk->setRawKey(
+          std::string(reinterpret_cast<const char*>(raw_key), out_len));
+      jwk->kty_ = "OKP";
+      jwk->crv_ = "Ed25519";
+      break;
+    }
+#endif
+    default:
+      return Status::JwksPemNotImplementedKty;
+  }
+  jwk->thumbprint_ = computeJwkThumbprint(*jwk);
+  return Status::Ok;
+}
+
+// Whether der is a certificate of the key of jwk, compared by their
+// RFC 7638 thumbprints, so that lazily loaded keys need not be built.
+bool certificateHoldsKey(absl::string_view der, const Jwks::Pubkey& jwk) {
+  if (jwk.thumbprint_.empty()) {
+    return false;
+  }
+  const uint8_t* data = castToUChar(der);
+  bssl::UniquePtr<X509> x509(d2i_X509(nullptr, &data, der.size()));
+  bssl::UniquePtr<EVP_PKEY> evp_pkey(
+      x509 == nullptr ? nullptr : X509_get_pubkey(x509.get()));
+  Jwks::Pubkey cert_key;
+  if (evp_pkey == nullptr ||
+      extractEvpPkey(evp_pkey.get(), /*intern=*/false, &cert_key) !=
+          Status::Ok) {
+    ERR_clear_error();
+    return false;
+  }
+  return cert_key.thumbprint_ == jwk.thumbprint_;
+}
+
+Status extractJwk(JwkMembers* jwk_members, const Jwks::LoadOptions& options,
+                  Jwks::Pubkey* jwk) {
   // Check "kty" parameter, it should exist.
   // https://tools.ietf.org/html/rfc7517#section-4.1
-  auto code = jwk_getter.GetString("kty", &jwk->kty_);
+  std::string kty_str;
+  auto code = takeMember(&jwk_members->kty, &kty_str);
   if (code == StructUtils::MISSING) {
     return Status::JwksMissingKty;
   }
@@ -346,80 +787,441 @@ Status extractJwk(const ::google::protobuf::Struct& jwk_pb, Jwks::Pubkey* jwk) {
 
   // "kid" and "alg" are optional, if they do not exist, set them to
   // empty. https://tools.ietf.org/html/rfc7517#page-8
-  jwk_getter.GetString("kid", &jwk->kid_);
-  jwk_getter.GetString("alg", &jwk->alg_);
+  takeMember(&jwk_members->kid, &jwk->kid_);
+  takeMember(&jwk_members->alg, &jwk->alg_);
 
   // Extract public key according to "kty" value.
   // https://tools.ietf.org/html/rfc7518#section-6.1
-  if (jwk->kty_ == "EC") {
-    return extractJwkFromJwkEC(jwk_pb, jwk);
-  } else if (jwk->kty_ == "RSA") {
-    return extractJwkFromJwkRSA(jwk_pb, jwk);
-  } else if (jwk->kty_ == "oct") {
-    return extractJwkFromJwkOct(jwk_pb, jwk);
-  } else if (jwk->kty_ == "OKP") {
-    return extractJwkFromJwkOKP(jwk_pb, jwk);
+  Status status;
+  if (kty_str == "EC") {
+    jwk->kty_ = "EC";
+    status = extractJwkFromJwkEC(jwk_members, options, jwk);
+  } else if (kty_str == "RSA") {
+    jwk->kty_ = "RSA";
+    status = extractJwkFromJwkRSA(jwk_members, options, jwk);
+  } else if (kty_str == "oct") {
+    jwk->kty_ = "oct";
+    status = extractJwkFromJwkOct(jwk_members, jwk);
+  } else if (kty_str == "OKP") {
+    jwk->kty_ = "OKP";
+    status = extractJwkFromJwkOKP(jwk_members, jwk);
+  } else {
+    return Status::JwksNotImplementedKty;
+  }
+  if (status != Status::Ok) {
+    return status;
+  }
+
+  // The first certificate of "x5c" holds the key. It is standard, not
+  // base64url, encoded. https://tools.ietf.org/html/rfc7517#section-4.7
+  // A certificate of another key gives no thumbprints, or they would select
+  // this key for tokens of that one.
+  std::string der;
+  if (jwk_members->x5c.code == StructUtils::OK &&
+      absl::Base64Unescape(jwk_members->x5c.value, &der) &&
+      certificateHoldsKey(der, *jwk)) {
+    setCertThumbprints(der, jwk);
+  }
+  return Status::Ok;
+}
+
+Status extractEmbeddedJwk(const EmbeddedJwk& embedded, Jwks::Pubkey* jwk) {
+  jwk->kid_ = embedded.kid;
+  jwk->alg_ = embedded.alg;
+  const absl::string_view kty = embedded.kty;
+  const absl::string_view crv = embedded.crv;
+  const absl::string_view first(reinterpret_cast<const char*>(embedded.first),
+                                embedded.first_size);
+  const absl::string_view second(
+      reinterpret_cast<const char*>(embedded.second), embedded.second_size);
+
+  KeyGetter e;
+  if (kty == "RSA") {
+    jwk->kty_ = "RSA";
+    jwk->setRsa(e.createRsaFromBytes(first, second));
+  } else if (kty == "EC") {
+    jwk->kty_ = "EC";
+    int nid;
+    if (crv == "P-256") {
+      nid = NID_X9_62_prime256v1;
+      jwk->crv_ = "P-256";
+    } else if (crv == "P-384") {
+      nid = NID_secp384r1;
+      jwk->crv_ = "P-384";
+    } else if (crv == "P-521") {
+      nid = NID_secp521r1;
+      jwk->crv_ = "P-521";
+    } else {
+      return Status::JwksECKeyAlgOrCrvUnsupported;
+    }
+    jwk->setEcKey(e.createEcKeyFromBytes(nid, first, second));
+  } else if (kty == "oct") {
+    jwk->kty_ = "oct";
+    if (first.empty()) {
+      return Status::JwksHMACKeyMissingK;
+    }
+    jwk->setRawKey(std::string(first));
+  } else if (kty == "OKP") {
+    jwk->kty_ = "OKP";
+    if (crv != "Ed25519") {
+      return Status::JwksOKPKeyCrvUnsupported;
+    }
+    jwk->crv_ = "Ed25519";
+    jwk->setRawKey(e.createRawKeyFromBytesOKP(ED25519_PUBLIC_KEY_LEN, first));
+  } else {
+    return Status::JwksNotImplementedKty;
+  }
+  if (e.getStatus() != Status::Ok) {
+    return e.getStatus();
+  }
+
+  jwk->thumbprint_ = embedded.thumbprint;
+  jwk->x5t_ = embedded.x5t;
+  jwk->x5t_s256_ = embedded.x5t_s256;
+  return Status::Ok;
+}
+
+// Extracts a key of a JwkSet message. It is checked like a key of a JWKS,
+// with the same statuses; an empty field is a missing one.
+Status extractProtoJwk(const JwkSet::Key& key, Jwks::Pubkey* jwk) {
+  if (key.kty().empty()) {
+    return Status::JwksMissingKty;
+  }
+  jwk->kid_ = key.kid();
+  jwk->alg_ = key.alg();
+
+  KeyGetter e;
+  if (key.kty() == "RSA") {
+    jwk->kty_ = "RSA";
+    Status status = checkKeyAlg("RSA", jwk->alg_);
+    if (status != Status::Ok) {
+      return status;
+    }
+    if (key.n().empty()) {
+      return Status::JwksRSAKeyMissingN;
+    }
+    if (key.e().empty()) {
+      return Status::JwksRSAKeyMissingE;
+    }
+    jwk->setRsa(e.createRsaFromBytes(key.n(), key.e()));
+  } else if (key.kty() == "EC") {
+    jwk->kty_ = "EC";
+    Status status = checkKeyAlg("EC", jwk->alg_);
+    if (status != Status::Ok) {
+      return status;
+    }
+    int nid;
+    status = resolveEcCurve(key.crv(), jwk, &nid);
+    if (status != Status::Ok) {
+      return status;
+    }
+    if (key.x().empty()) {
+      return Status::JwksECKeyMissingX;
+    }
+    if (key.y().empty()) {
+      return Status::JwksECKeyMissingY;
+    }
+    jwk->setEcKey(e.createEcKeyFromBytes(nid, key.x(), key.y()));
+  } else if (key.kty() == "oct") {
+    jwk->kty_ = "oct";
+    Status status = checkKeyAlg("oct", jwk->alg_);
+    if (status != Status::Ok) {
+      return status;
+    }
+    if (key.k().empty()) {
+      return Status::JwksHMACKeyMissingK;
+    }
+    jwk->setRawKey(key.k());
+  } else if (key.kty() == "OKP") {
+    jwk->kty_ = "OKP";
+    Status status = checkKeyAlg("OKP", jwk->alg_);
+    if (status != Status::Ok) {
+      return status;
+    }
+    if (key.crv().empty()) {
+      return Status::JwksOKPKeyMissingCrv;
+    }
+    if (key.crv() != "Ed25519") {
+      return Status::JwksOKPKeyCrvUnsupported;
+    }
+    jwk->crv_ = "Ed25519";
+    if (key.x().empty()) {
+      return Status::JwksOKPKeyMissingX;
+    }
+    jwk->setRawKey(e.createRawKeyFromBytesOKP(ED25519_PUBLIC_KEY_LEN, key.x()));
+  } else {
+    return Status::JwksNotImplementedKty;
+  }
+  if (e.getStatus() != Status::Ok) {
+    return e.getStatus();
   }
-  return Status::JwksNotImplementedKty;
+
+  // Computed from the key material, so that leading zero bytes in n or e do
+  // not change the thumbprint.
+  jwk->thumbprint_ = computeJwkThumbprint(*jwk);
+  return Status::Ok;
 }
 
-Status extractX509(const std::string& key, Jwks::Pubkey* jwk) {
-  jwk->bio_.reset(BIO_new(BIO_s_mem()));
-  if (BIO_write(jwk->bio_.get(), key.c_str(), key.length()) <= 0) {
+Status extractX509(const std::string& key, const Jwks::LoadOptions& options,
+                   Jwks::Pubkey* jwk) {
+  // An unchanged certificate reuses the key and thumbprints extracted from
+  // it before, without being decoded again. The certificate itself is only
+  // parsed when it has to be kept.
+  X509KeyCache& cache = X509KeyCache::global();
+  std::string fingerprint;
+  if (!options.retain_x509 && cache.enabled()) {
+    fingerprint = X509KeyCache::fingerprint(key);
+    X509KeyCache::Entry entry;
+    if (cache.find(fingerprint, &entry)) {
+      jwk->setRsa(std::move(entry.rsa));
+      jwk->thumbprint_ = std::move(entry.jwk_thumbprint);
+      jwk->x5t_ = std::move(entry.x5t);
+      jwk->x5t_s256_ = std::move(entry.x5t_s256);
+      return Status::Ok;
+    }
+  }
+
+  bssl::UniquePtr<BIO> bio(BIO_new(BIO_s_mem()));
+  if (BIO_write(bio.get(), key.c_str(), key.length()) <= 0) {
     return Status::JwksX509BioWriteError;
   }
-  jwk->x509_.reset(
-      PEM_read_bio_X509(jwk->bio_.get(), nullptr, nullptr, nullptr));
-  if (jwk->x509_ == nullptr) {
+  char* name = nullptr;
+  char* header = nullptr;
+  uint8_t* data = nullptr;
+  long len = 0;
+  if (!PEM_read_bio(bio.get(), &name, &header, &data, &len)) {
+    ERR_clear_error();
+    return Status::JwksX509ParseError;
+  }
+  bssl::UniquePtr<char> name_owner(name);
+  bssl::UniquePtr<char> header_owner(header);
+  bssl::UniquePtr<uint8_t> data_owner(data);
+
+  const uint8_t* der = data;
+  bssl::UniquePtr<X509> x509(d2i_X509(nullptr, &der, len));
+  if (x509 == nullptr) {
     return Status::JwksX509ParseError;
   }
-  bssl::UniquePtr<EVP_PKEY> tmp_pkey(X509_get_pubkey(jwk->x509_.get()));
+  bssl::UniquePtr<EVP_PKEY> tmp_pkey(X509_get_pubkey(x509.get()));
   if (tmp_pkey == nullptr) {
     return Status::JwksX509GetPubkeyError;
   }
-  jwk->rsa_.reset(EVP_PKEY_get1_RSA(tmp_pkey.get()));
-  if (jwk->rsa_ == nullptr) {
+  bssl::UniquePtr<RSA> rsa = KeyInternTable::global().intern(
+      bssl::UniquePtr<RSA>(EVP_PKEY_get1_RSA(tmp_pkey.get())));
+  if (rsa == nullptr) {
     return Status::JwksX509GetPubkeyError;
   }
+  jwk->setRsa(std::move(rsa));
+  jwk->thumbprint_ = computeJwkThumbprint(*jwk);
+  setCertThumbprints(
+      absl::string_view(reinterpret_cast<const char*>(data), len), jwk);
+
+  if (options.retain_x509) {
+    jwk->x509_ = std::move(x509);
+  } else if (!fingerprint.empty()) {
+    X509KeyCache::Entry entry;
+    RSA_up_ref(jwk->rsa());
+    entry.rsa.reset(jwk->rsa());
+    entry.jwk_thumbprint = jwk->thumbprint_;
+    entry.x5t = jwk->x5t_;
+    entry.x5t_s256 = jwk->x5t_s256_;
+    cache.insert(fingerprint, entry);
+  }
   return Status::Ok;
 }
 
-bool shouldCheckX509(const ::google::protobuf::Struct& jwks_pb) {
-  if (jwks_pb.fields().empty()) {
-    return false;
+// Whether a member of a key set may be an entry of an x509 key map.
+bool isX509Entry(absl::string_view kid, absl::string_view cert) {
+  return !kid.empty() && absl::StartsWith(cert, kX509CertPrefix) &&
+         absl::EndsWith(cert, kX509CertSuffix);
+}
+
+// Sets the JWKS parameters not specified within a PEM key.
+void setPemKidAlg(const std::string& kid, const std::string& alg,
+                  Jwks::Pubkey* jwk) {
+  jwk->kid_ = kid;
+  jwk->alg_ = alg;
+
+  // If alg is a known EC algorithm, set the correct crv as well.
+  if (jwk->alg_ == "ES256") {
+    jwk->crv_ = "P-256";
+  }
+  if (jwk->alg_ == "ES384") {
+    jwk->crv_ = "P-384";
   }
+  if (jwk->alg_ == "ES512") {
+    jwk->crv_ = "P-521";
+  }
+}
 
-  for (const auto& kid : jwks_pb.fields()) {
-    if (kid.first.empty() ||
-        kid.second.kind_case() != google::protobuf::Value::kStringValue) {
-      return false;
+}  // namespace
+
+Jwks::Pubkey::~Pubkey() { resetMaterial(); }
+
+void Jwks::Pubkey::resetMaterial() {
+  switch (material_) {
+    case Material::None:
+      break;
+    case Material::Rsa:
+      RSA_free(key_.rsa);
+      break;
+    case Material::EcKey:
+      EC_KEY_free(key_.ec_key);
+      break;
+    case Material::Raw:
+      delete key_.raw;
+      break;
+    case Material::Lazy:
+      delete key_.lazy;
+      break;
+  }
+  material_ = Material::None;
+  key_.rsa = nullptr;
+}
+
+void Jwks::Pubkey::setRsa(bssl::UniquePtr<RSA> rsa) {
+  resetMaterial();
+  if (rsa != nullptr) {
+    key_.rsa = rsa.release();
+    material_ = Material::Rsa;
+  }
+}
+
+void Jwks::Pubkey::setEcKey(bssl::UniquePtr<EC_KEY> ec_key) {
+  resetMaterial();
+  if (ec_key != nullptr) {
+    key_.ec_key = ec_key.release();
+    material_ = Material::EcKey;
+  }
+}
+
+void Jwks::Pubkey::setRawKey(std::string raw_key) {
+  resetMaterial();
+  key_.raw = new std::string(std::move(raw_key));
+  material_ = Material::Raw;
+}
+
+void Jwks::Pubkey::setLazy(std::unique_ptr<LazyFields> lazy) {
+  resetMaterial();
+  if (lazy != nullptr) {
+    key_.lazy = lazy.release();
+    material_ = Material::Lazy;
+  }
+}
+
+Status Jwks::Pubkey::materialize() {
+  std::call_once(materialize_once_, [this] {
+    const LazyFields* fields = lazy();
+    if (fields == nullptr) {
+      return;
     }
-    const std::string& cert = kid.second.string_value();
-    if (!absl::StartsWith(cert, kX509CertPrefix) ||
-        !absl::EndsWith(cert, kX509CertSuffix)) {
-      return false;
+    KeyGetter e;
+    if (kty_ == "RSA") {
+      setRsa(e.createRsaFromJwk(fields->first, fields->second));
+    } else if (kty_ == "EC") {
+      setEcKey(
+          e.createEcKeyFromJwkEC(fields->nid, fields->first, fields->second));
+    } else {
+      resetMaterial();
     }
-  }
-  return true;
+    materialize_status_ = e.getStatus();
+  });
+  return materialize_status_;
 }
 
-Status createFromX509(const ::google::protobuf::Struct& jwks_pb,
-                      std::vector<Jwks::PubkeyPtr>& keys) {
-  for (const auto& kid : jwks_pb.fields()) {
-    Jwks::PubkeyPtr key_ptr(new Jwks::Pubkey());
-    Status status = extractX509(kid.second.string_value(), key_ptr.get());
-    if (status != Status::Ok) {
-      return status;
+size_t Jwks::Pubkey::memoryUsage() const {
+  size_t total = sizeof(Pubkey) + stringMemory(kid_) + stringMemory(alg_) +
+                 stringMemory(kty_) + stringMemory(crv_) +
+                 stringMemory(thumbprint_) + stringMemory(x5t_) +
+                 stringMemory(x5t_s256_);
+  switch (material_) {
+    case Material::None:
+      break;
+    case Material::Rsa:
+      // n, e and the Montgomery modulus.
+      total += kRsaOverhead + 3 * RSA_size(key_.rsa);
+      break;
+    case Material::EcKey: {
+      const EC_GROUP* group = EC_KEY_get0_group(key_.ec_key);
+      total += kEcKeyOverhead + 3 * (EC_GROUP_get_degree(group) + 7) / 8;
+      break;
     }
+    case Material::Raw:
+      total += sizeof(std::string) + stringMemory(*key_.raw);
+      break;
+    case Material::Lazy:
+      total += sizeof(LazyFields) + stringMemory(key_.lazy->first) +
+               stringMemory(key_.lazy->second);
+      break;
+  }
+  if (x509_ != nullptr) {
+    total += kX509Overhead;
+  }
+  return total;
+}
 
-    key_ptr->kid_ = kid.first;
-    key_ptr->kty_ = "RSA";
-    keys.push_back(std::move(key_ptr));
+size_t Jwks::memoryUsage() const {
+  size_t total = sizeof(Jwks) + keys_.capacity() * sizeof(PubkeyPtr) +
+                 thumbprint_index_.capacity() *
+                     (sizeof(decltype(thumbprint_index_)::value_type) + 1);
+  for (const auto& key : keys_) {
+    total += key->memoryUsage();
   }
-  return Status::Ok;
+  return total;
 }
 
-}  // namespace
+std::string Jwks::computeThumbprint(const ThumbprintMembers& members) {
+  std::string first;
+  std::string second;
+  std::string json;
+  if (members.kty == "RSA") {
+    if (!canonicalBase64UrlUInt(members.e, 0, &first) ||
+        !canonicalBase64UrlUInt(members.n, 0, &second)) {
+      return "";
+    }
+    json = absl::StrCat(R"({"e":")", first, R"(","kty":"RSA","n":")", second,
+                        R"("})");
+  } else if (members.kty == "EC") {
+    const size_t len = curveCoordinateSize(members.crv);
+    if (!canonicalBase64UrlUInt(members.x, len, &first) ||
+        !canonicalBase64UrlUInt(members.y, len, &second)) {
+      return "";
+    }
+    json = absl::StrCat(R"({"crv":")", members.crv, R"(","kty":"EC","x":")",
+                        first, R"(","y":")", second, R"("})");
+  } else if (members.kty == "OKP") {
+    // x is an octet string, not an integer, so only its encoding changes.
+    std::string bytes;
+    if (!absl::WebSafeBase64Unescape(members.x, &bytes)) {
+      return "";
+    }
+    absl::WebSafeBase64Escape(bytes, &first);
+    json = absl::StrCat(R"({"crv":")", members.crv, R"(","kty":"OKP","x":")",
+                        first, R"("})");
+  } else {
+    return "";
+  }
+  return base64UrlSha256(json);
+}
+
+Jwks::Pubkey* Jwks::findByThumbprint(absl::string_view thumbprint) const {
+  const auto it = thumbprint_index_.find(thumbprint);
+  return it == thumbprint_index_.end() ? nullptr : it->second;
+}
+
+void Jwks::buildThumbprintIndex() {
+  thumbprint_index_.clear();
+  thumbprint_index_.reserve(keys_.size());
+  for (const auto& key : keys_) {
+    for (const std::string* thumbprint :
+         {&key->thumbprint_, &key->x5t_, &key->x5t_s256_}) {
+      if (!thumbprint->empty()) {
+        // The first key with a thumbprint wins.
+        thumbprint_index_.emplace(*thumbprint, key.get());
+      }
+    }
+  }
+}
 
 Status Jwks::addKeyFromPem(const std::string& pkey, const std::string& kid,
                            const std::string& alg) {
@@ -429,19 +1231,35 @@ Status Jwks::addKeyFromPem(const std::string& pkey, const std::string& kid,
   }
   keys_.insert(keys_.end(), std::make_move_iterator(tmp->keys_.begin()),
                std::make_move_iterator(tmp->keys_.end()));
+  buildThumbprintIndex();
   return Status::Ok;
 }
 
 JwksPtr Jwks::createFrom(const std::string& pkey, Type type) {
+  return createFrom(pkey, type, LoadOptions());
+}
+
+JwksPtr Jwks::createFrom(const std::string& pkey, Type type,
+                         const LoadOptions& options) {
   JwksPtr keys(new Jwks());
   switch (type) {
     case Type::JWKS:
-      keys->createFromJwksCore(pkey);
+      keys->createFromJwksCore(pkey, options);
       break;
     case Type::PEM:
       keys->createFromPemCore(pkey);
       break;
+    case Type::PROTO: {
+      JwkSet jwk_set;
+      if (!jwk_set.ParseFromString(pkey)) {
+        keys->updateStatus(Status::JwksProtoParseError);
+        break;
+      }
+      keys->createFromProtoCore(jwk_set);
+      break;
+    }
   }
+  keys->buildThumbprintIndex();
   return keys;
 }
 
@@ -455,26 +1273,13 @@ JwksPtr Jwks::createFromPem(const std::string& pkey, const std::string& kid,
     ret->updateStatus(Status::JwksPemBadBase64);
     return ret;
   }
-  Pubkey* jwk = ret->keys_.at(0).get();
-  jwk->kid_ = kid;
-  jwk->alg_ = alg;
-
-  // If alg is a known EC algorithm, set the correct crv as well.
-  if (jwk->alg_ == "ES256") {
-    jwk->crv_ = "P-256";
-  }
-  if (jwk->alg_ == "ES384") {
-    jwk->crv_ = "P-384";
-  }
-  if (jwk->alg_ == "ES512") {
-    jwk->crv_ = "P-521";
-  }
+  setPemKidAlg(kid, alg, ret->keys_.at(0).get());
   return ret;
 }
 
 // pkey_pem must be a PEM-encoded PKCS #8 public key.
 // This is the format that starts with -----BEGIN PUBLIC KEY-----.
-void Jwks::createFromPemCore(const std::string& pkey_pem) {
+void Jwks::createFromPemCore(absl::string_view pkey_pem) {
   keys_.clear();
   PubkeyPtr key_ptr(new Pubkey());
   KeyGetter e;
@@ -487,73 +1292,245 @@ void Jwks::createFromPemCore(const std::string& pkey_pem) {
   }
   assert(e.getStatus() == Status::Ok);
 
-  switch (EVP_PKEY_id(evp_pkey.get())) {
-    case EVP_PKEY_RSA:
-      key_ptr->rsa_.reset(EVP_PKEY_get1_RSA(evp_pkey.get()));
-      key_ptr->kty_ = "RSA";
-      break;
-    case EVP_PKEY_EC:
-      key_ptr->ec_key_.reset(EVP_PKEY_get1_EC_KEY(evp_pkey.get()));
-      key_ptr->kty_ = "EC";
+  Status status =
+      extractEvpPkey(evp_pkey.get(), /*intern=*/true, key_ptr.get());
+  if (status != Status::Ok) {
+    updateStatus(status);
+    return;
+  }
+  keys_.push_back(std::move(key_ptr));
+}
+
+JwksPtr Jwks::createFromPemBundle(const std::string& bundle,
+                                  const std::vector<PemKeyInfo>& key_infos) {
+  JwksPtr keys(new Jwks());
+  bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(bundle.data(), bundle.size()));
+  if (bio == nullptr) {
+    keys->updateStatus(Status::JwksBioAllocError);
+    return keys;
+  }
+
+  // Read the blocks one by one in a single pass. Like keys in a JWKS, blocks
+  // that fail to parse are skipped, but still take their place in key_infos.
+  size_t index = 0;
+  for (;; ++index) {
+    char* name = nullptr;
+    char* header = nullptr;
+    uint8_t* data = nullptr;
+    long len = 0;
+    if (!PEM_read_bio(bio.get(), &name, &header, &data, &len)) {
+      // The end of the bundle.
+      ERR_clear_error();
       break;
-#ifndef BORINGSSL_FIPS
-    case EVP_PKEY_ED25519: {
-      uint8_t raw_key[ED25519_PUBLIC_KEY_LEN];
-      size_t out_len = ED25519_PUBLIC_KEY_LEN;
-      if (EVP_PKEY_get_raw_public_key(evp_pkey.get(), raw_key, &out_len) != 1 ||
-          out_len != ED25519_PUBLIC_KEY_LEN) {
-        updateStatus(Status::JwksPemGetRawEd25519Error);
-        return;
+    }
+    bssl::UniquePtr<char> name_owner(name);
+    bssl::UniquePtr<char> header_owner(header);
+    bssl::UniquePtr<uint8_t> data_owner(data);
+
+    bssl::UniquePtr<EVP_PKEY> evp_pkey;
+    bool is_certificate = false;
+    const uint8_t* der = data;
+    if (strcmp(name, PEM_STRING_PUBLIC) == 0) {
+      evp_pkey.reset(d2i_PUBKEY(nullptr, &der, len));
+    } else if (strcmp(name, PEM_STRING_X509) == 0) {
+      bssl::UniquePtr<X509> x509(d2i_X509(nullptr, &der, len));
+      if (x509 != nullptr) {
+        evp_pkey.reset(X509_get_pubkey(x509.get()));
       }
-      key_ptr->okp_key_raw_ =
-          std::string(reinterpret_cast<const char*>(raw_key), out_len);
-      key_ptr->kty_ = "OKP";
-      key_ptr->crv_ = "Ed25519";
-      break;
+      is_certificate = true;
     }
-#endif
-    default:
-      updateStatus(Status::JwksPemNotImplementedKty);
-      return;
+    if (evp_pkey == nullptr) {
+      ERR_clear_error();
+      keys->updateStatus(is_certificate ? Status::JwksX509ParseError
+                                        : Status::JwksPemBadBase64);
+      continue;
+    }
+
+    PubkeyPtr key_ptr(new Pubkey());
+    Status status =
+        extractEvpPkey(evp_pkey.get(), /*intern=*/true, key_ptr.get());
+    if (status != Status::Ok) {
+      keys->updateStatus(status);
+      continue;
+    }
+    if (is_certificate) {
+      setCertThumbprints(
+          absl::string_view(reinterpret_cast<const char*>(data), len),
+          key_ptr.get());
+    }
+    if (index < key_infos.size()) {
+      setPemKidAlg(key_infos[index].kid, key_infos[index].alg, key_ptr.get());
+    } else {
+      key_ptr->kid_ = key_ptr->thumbprint_;
+    }
+    keys->keys_.push_back(std::move(key_ptr));
   }
 
-  keys_.push_back(std::move(key_ptr));
+  if (keys->keys_.empty()) {
+    keys->updateStatus(index == 0 ? Status::JwksPemBadBase64
+                                  : Status::JwksNoValidKeys);
+  } else {
+    keys->resetStatus(Status::Ok);
+  }
+  keys->buildThumbprintIndex();
+  return keys;
 }
 
-void Jwks::createFromJwksCore(const std::string& jwks_json) {
+JwksPtr Jwks::createFromEmbedded(const EmbeddedJwks& embedded) {
+  JwksPtr keys(new Jwks());
+  keys->keys_.reserve(embedded.size);
+  for (size_t i = 0; i < embedded.size; ++i) {
+    PubkeyPtr key_ptr(new Pubkey());
+    Status status = extractEmbeddedJwk(embedded.keys[i], key_ptr.get());
+    if (status == Status::Ok) {
+      keys->keys_.push_back(std::move(key_ptr));
+    } else {
+      keys->updateStatus(status);
+    }
+  }
+
+  if (keys->keys_.empty()) {
+    keys->updateStatus(embedded.size == 0 ? Status::JwksNoKeys
+                                          : Status::JwksNoValidKeys);
+  } else {
+    keys->resetStatus(Status::Ok);
+  }
+  keys->buildThumbprintIndex();
+  return keys;
+}
+
+JwksPtr Jwks::createFromProto(const JwkSet& jwk_set) {
+  JwksPtr keys(new Jwks());
+  keys->createFromProtoCore(jwk_set);
+  keys->buildThumbprintIndex();
+  return keys;
+}
+
+void Jwks::createFromProtoCore(const JwkSet& jwk_set) {
   keys_.clear();
+  keys_.reserve(jwk_set.keys_size());
+  for (const JwkSet::Key& key : jwk_set.keys()) {
+    PubkeyPtr key_ptr(new Pubkey());
+    Status status = extractProtoJwk(key, key_ptr.get());
+    if (status == Status::Ok) {
+      keys_.push_back(std::move(key_ptr));
+    } else {
+      updateStatus(status);
+    }
+  }
+
+  if (keys_.empty()) {
+    updateStatus(jwk_set.keys_size() == 0 ? Status::JwksNoKeys
+                                          : Status::JwksNoValidKeys);
+  } else {
+    resetStatus(Status::Ok);
+  }
+}
+
+void Jwks::createFromJwksCore(absl::string_view jwks_json,
+                              const LoadOptions& load_options) {
+  keys_.clear();
+
+  // The document is read in a single pass. Each key is extracted as soon as
+  // its object is read, so only one key's members are held at a time.
+  JsonReader reader(jwks_json);
+  bool has_keys = false;
+  bool bad_keys = false;
+  // A document without "keys" may be an x509 key map, whose members all map
+  // a kid to a certificate. Its keys are extracted as they are read, and
+  // dropped if another member shows it is not one.
+  bool maybe_x509 = true;
+  size_t x509_entries = 0;
+  std::vector<PubkeyPtr> x509_keys;
+  Status x509_status = Status::Ok;
 
-  ::google::protobuf::util::JsonParseOptions options;
-  ::google::protobuf::Struct jwks_pb;
-  const auto status = ::google::protobuf::util::JsonStringToMessage(
-      jwks_json, &jwks_pb, options);
-  if (!status.ok()) {
-    updateStatus(Status::JwksParseError);
+  absl::string_view name;
+  if (reader.beginObject()) {
+    while (reader.nextMember(&name)) {
+      if (name == "keys") {
+        has_keys = true;
+        bad_keys = reader.peek() != JsonReader::Type::Array;
+        if (bad_keys) {
+          reader.skipValue();
+        } else {
+          readKeys(&reader, load_options);
+        }
+        continue;
+      }
+
+      if (!maybe_x509 || reader.peek() != JsonReader::Type::String) {
+        maybe_x509 = false;
+        x509_keys.clear();
+        reader.skipValue();
+        continue;
+      }
+      const std::string kid(name);
+      std::string cert;
+      if (!reader.readString(&cert)) {
+        break;
+      }
+      if (!isX509Entry(kid, cert)) {
+        maybe_x509 = false;
+        x509_keys.clear();
+        continue;
+      }
+      ++x509_entries;
+      if (x509_status != Status::Ok) {
+        // Like a key set, an x509 key map stops at its first bad key.
+        continue;
+      }
+      PubkeyPtr key_ptr(new Pubkey());
+      x509_status = extractX509(cert, load_options, key_ptr.get());
+      if (x509_status == Status::Ok) {
+        key_ptr->kid_ = kid;
+        key_ptr->kty_ = "RSA";
+        x509_keys.push_back(std::move(key_ptr));
+      }
+    }
+  }
+  if (!reader.done()) {
+    keys_.clear();
+    resetStatus(Status::JwksParseError);
     return;
   }
 
-  const auto& fields = jwks_pb.fields();
-  const auto keys_it = fields.find("keys");
-  if (keys_it == fields.end()) {
-    // X509 doesn't have "keys" field.
-    if (shouldCheckX509(jwks_pb)) {
-      updateStatus(createFromX509(jwks_pb, keys_));
+  if (!has_keys) {
+    if (maybe_x509 && x509_entries > 0) {
+      keys_ = std::move(x509_keys);
+      updateStatus(x509_status);
       return;
     }
     updateStatus(Status::JwksNoKeys);
     return;
   }
-  if (keys_it->second.kind_case() != google::protobuf::Value::kListValue) {
+  if (bad_keys) {
     updateStatus(Status::JwksBadKeys);
     return;
   }
+  if (keys_.empty()) {
+    updateStatus(Status::JwksNoValidKeys);
+  } else {
+    resetStatus(Status::Ok);
+  }
+}
 
-  for (const auto& key_value : keys_it->second.list_value().values()) {
-    if (key_value.kind_case() != ::google::protobuf::Value::kStructValue) {
+void Jwks::readKeys(JsonReader* reader, const LoadOptions& load_options) {
+  if (!reader->beginArray()) {
+    return;
+  }
+  while (reader->nextElement()) {
+    if (reader->peek() != JsonReader::Type::Object) {
+      if (!reader->skipValue()) {
+        return;
+      }
       continue;
     }
+    JwkMembers members;
+    if (!readJwkMembers(reader, &members)) {
+      return;
+    }
     PubkeyPtr key_ptr(new Pubkey());
-    Status status = extractJwk(key_value.struct_value(), key_ptr.get());
+    Status status = extractJwk(&members, load_options, key_ptr.get());
     if (status == Status::Ok) {
       keys_.push_back(std::move(key_ptr));
       resetStatus(status);
@@ -561,12 +1538,6 @@ void Jwks::createFromJwksCore(const std::string& jwks_json) {
       updateStatus(status);
     }
   }
-
-  if (keys_.empty()) {
-    updateStatus(Status::JwksNoValidKeys);
-  } else {
-    resetStatus(Status::Ok);
-  }
 }
 
 }  // namespace jwt_verify
@@ -0,0 +1,166 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/jwks_directory.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "absl/strings/match.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+// A read-only memory mapping of a whole file.
+class MappedFile {
+ public:
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      munmap(data_, size_);
+    }
+  }
+
+  bool open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+    if (ok && st.st_size > 0) {
+      void* data =
+          mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, /*offset=*/0);
+      if (data == MAP_FAILED) {
+        ok = false;
+      } else {
+        data_ = data;
+        size_ = st.st_size;
+      }
+    }
+    close(fd);
+    return ok;
+  }
+
+  absl::string_view contents() const {
+    // Empty files are not mapped; BIO_new_mem_buf rejects a null buffer.
+    if (data_ == nullptr) {
+      return "";
+    }
+    return absl::string_view(static_cast<const char*>(data_), size_);
+  }
+
+ private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Lists the key files of a directory, sorted by name.
+bool listKeyFiles(const std::string& path, std::vector<std::string>* names) {
+  DIR* dir = opendir(path.c_str());
+  if (dir == nullptr) {
+    return false;
+  }
+  while (const struct dirent* entry = readdir(dir)) {
+    const std::string name = entry->d_name;
+    if (absl::EndsWith(name, ".pem") || absl::EndsWith(name, ".json") ||
+        absl::EndsWith(name, ".jwks")) {
+      names->push_back(name);
+    }
+  }
+  closedir(dir);
+  std::sort(names->begin(), names->end());
+  return true;
+}
+
+}  // namespace
+
+JwksPtr loadJwksDirectory(const std::string& path,
+                          const Jwks::LoadOptions& options,
+                          std::vector<Jwks::FileStatus>* file_statuses) {
+  JwksPtr keys(new Jwks());
+  std::vector<std::string> names;
+  if (!listKeyFiles(path, &names)) {
+    keys->updateStatus(Status::JwksFileReadError);
+    return keys;
+  }
+
+  // Each file is parsed into its own key set by one of the threads, which
+  // take the next file from a shared counter.
+  std::vector<JwksPtr> loaded(names.size());
+  std::atomic<size_t> next{0};
+  auto load_files = [&] {
+    for (size_t i = next++; i < names.size(); i = next++) {
+      JwksPtr file_keys(new Jwks());
+      MappedFile file;
+      if (!file.open(path + "/" + names[i])) {
+        file_keys->updateStatus(Status::JwksFileReadError);
+      } else if (absl::EndsWith(names[i], ".pem")) {
+        file_keys->createFromPemCore(file.contents());
+        if (file_keys->getStatus() == Status::Ok) {
+          file_keys->keys_[0]->kid_ =
+              names[i].substr(0, names[i].size() - sizeof(".pem") + 1);
+        }
+      } else {
+        file_keys->createFromJwksCore(file.contents(), options);
+      }
+      loaded[i] = std::move(file_keys);
+    }
+  };
+  size_t threads = options.threads > 0 ? options.threads
+                                       : std::thread::hardware_concurrency();
+  threads = std::max<size_t>(1, std::min(threads, names.size()));
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < threads; ++i) {
+    workers.emplace_back(load_files);
+  }
+  load_files();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  // Merge the keys of all files in one go.
+  size_t total = 0;
+  for (const auto& file_keys : loaded) {
+    total += file_keys->keys_.size();
+  }
+  keys->keys_.reserve(total);
+  for (size_t i = 0; i < loaded.size(); ++i) {
+    auto& file_keys = loaded[i]->keys_;
+    keys->keys_.insert(keys->keys_.end(),
+                       std::make_move_iterator(file_keys.begin()),
+                       std::make_move_iterator(file_keys.end()));
+    keys->updateStatus(loaded[i]->getStatus());
+    if (file_statuses != nullptr) {
+      file_statuses->push_back({path + "/" + names[i], loaded[i]->getStatus()});
+    }
+  }
+  keys->buildThumbprintIndex();
+  if (!keys->keys_.empty()) {
+    keys->resetStatus(Status::Ok);
+  } else if (names.empty()) {
+    keys->updateStatus(Status::JwksNoKeys);
+  }
+  return keys;
+}
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,263 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generates a C++ source file and header holding the decoded keys of a JWKS
+// or PEM bundle, to be loaded with Jwks::createFromEmbedded(). It is run by
+// the cc_embedded_jwks rule in jwks_embed.bzl.
+//
+// Usage:
+//   jwks_embed --type=jwks|pem --symbol=kKeys [--namespace=a::b]
+//       --include=path/to/out.h --out_h=out.h --out_cc=out.cc input
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "absl/strings/escaping.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "jwt_verify_lib/jwks.h"
+#include "openssl/bn.h"
+#include "openssl/ec.h"
+#include "openssl/rsa.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+struct Options {
+  std::string type = "jwks";
+  std::string symbol;
+  std::string ns;
+  std::string include;
+  std::string out_h;
+  std::string out_cc;
+  std::string input;
+};
+
+bool parseOptions(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    const absl::string_view arg = argv[i];
+    if (!absl::StartsWith(arg, "--")) {
+      options->input = std::string(arg);
+      continue;
+    }
+    std::pair<std::string, std::string> flag =
+        absl::StrSplit(arg.substr(2), absl::MaxSplits('=', 1));
+    if (flag.first == "type") {
+      options->type = flag.second;
+    } else if (flag.first == "symbol") {
+      options->symbol = flag.second;
+    } else if (flag.first == "namespace") {
+      options->ns = flag.second;
+    } else if (flag.first == "include") {
+      options->include = flag.second;
+    } else if (flag.first == "out_h") {
+      options->out_h = flag.second;
+    } else if (flag.first == "out_cc") {
+      options->out_cc = flag.second;
+    } else {
+      return false;
+    }
+  }
+  return (options->type == "jwks" || options->type == "pem") &&
+         !options->symbol.empty() && !options->include.empty() &&
+         !options->out_h.empty() && !options->out_cc.empty() &&
+         !options->input.empty();
+}
+
+std::string bigNumBytes(const BIGNUM* bn, size_t len) {
+  std::string bytes(std::max<size_t>(len, BN_num_bytes(bn)), '\0');
+  BN_bn2bin(bn, reinterpret_cast<uint8_t*>(&bytes[0]) + bytes.size() -
+                    BN_num_bytes(bn));
+  return bytes;
+}
+
+// The decoded key material of a key, as stored in an EmbeddedJwk.
+struct KeyMaterial {
+  absl::string_view crv;
+  std::string first;
+  std::string second;
+};
+
+bool getKeyMaterial(const Jwks::Pubkey& key, KeyMaterial* material) {
+  if (key.rsa() != nullptr) {
+    material->first = bigNumBytes(RSA_get0_n(key.rsa()), 0);
+    material->second = bigNumBytes(RSA_get0_e(key.rsa()), 0);
+  } else if (key.ec_key() != nullptr) {
+    const EC_GROUP* group = EC_KEY_get0_group(key.ec_key());
+    switch (EC_GROUP_get_curve_name(group)) {
+      case NID_X9_62_prime256v1:
+        material->crv = "P-256";
+        break;
+      case NID_secp384r1:
+        material->crv = "P-384";
+        break;
+      case NID_secp521r1:
+        material->crv = "P-521";
+        break;
+      default:
+        return false;
+    }
+    bssl::UniquePtr<BIGNUM> x(BN_new());
+    bssl::UniquePtr<BIGNUM> y(BN_new());
+    if (!EC_POINT_get_affine_coordinates_GFp(
+            group, EC_KEY_get0_public_key(key.ec_key()), x.get(), y.get(),
+            nullptr)) {
+      return false;
+    }
+    const size_t len = (EC_GROUP_get_degree(group) + 7) / 8;
+    material->first = bigNumBytes(x.get(), len);
+    material->second = bigNumBytes(y.get(), len);
+  } else if (!key.raw_key().empty()) {
+    material->crv = key.crv_;
+    material->first = std::string(key.raw_key());
+  } else {
+    return false;
+  }
+  return true;
+}
+
+std::string quoted(absl::string_view str) {
+  return absl::StrCat("\"", absl::CEscape(str), "\"");
+}
+
+void writeByteArray(const std::string& name, const std::string& bytes,
+                    std::ostream& out) {
+  if (bytes.empty()) {
+    return;
+  }
+  out << "constexpr uint8_t " << name << "[] = {";
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    out << (i % 12 == 0 ? "\n    " : " ") << "0x"
+        << absl::BytesToHexString(absl::string_view(&bytes[i], 1)) << ",";
+  }
+  out << "\n};\n\n";
+}
+
+std::string arrayRef(const std::string& name, const std::string& bytes) {
+  return bytes.empty() ? "nullptr, 0"
+                       : absl::StrCat(name, ", sizeof(", name, ")");
+}
+
+void writeSource(const Options& options, const Jwks& jwks,
+                 const std::vector<absl::string_view>& namespaces,
+                 std::ostream& out) {
+  out << "// Generated by jwks_embed from " << options.input
+      << ". Do not edit.\n\n"
+      << "#include \"" << options.include << "\"\n\n";
+  for (absl::string_view ns : namespaces) {
+    out << "namespace " << ns << " {\n";
+  }
+  out << "namespace {\n\n";
+
+  std::ostringstream entries;
+  for (size_t i = 0; i < jwks.keys().size(); ++i) {
+    const Jwks::Pubkey& key = *jwks.keys()[i];
+    KeyMaterial material;
+    if (!getKeyMaterial(key, &material)) {
+      continue;
+    }
+    const std::string first = absl::StrCat("kKey", i, "First");
+    const std::string second = absl::StrCat("kKey", i, "Second");
+    writeByteArray(first, material.first, out);
+    writeByteArray(second, material.second, out);
+    entries << "    {" << quoted(key.kid_) << ", " << quoted(key.alg_) << ", "
+            << quoted(key.kty_) << ", " << quoted(material.crv) << ",\n"
+            << "     " << arrayRef(first, material.first) << ",\n"
+            << "     " << arrayRef(second, material.second) << ",\n"
+            << "     " << quoted(key.thumbprint_) << ",\n"
+            << "     " << quoted(key.x5t_) << ",\n"
+            << "     " << quoted(key.x5t_s256_) << "},\n";
+  }
+
+  out << "constexpr ::google::jwt_verify::EmbeddedJwk kKeys[] = {\n"
+      << entries.str() << "};\n\n"
+      << "}  // namespace\n\n"
+      << "const ::google::jwt_verify::EmbeddedJwks " << options.symbol
+      << " = {\n    kKeys, sizeof(kKeys) / sizeof(kKeys[0])};\n\n";
+  for (auto it = namespaces.rbegin(); it != namespaces.rend(); ++it) {
+    out << "}  // namespace " << *it << "\n";
+  }
+}
+
+void writeHeader(const Options& options,
+                 const std::vector<absl::string_view>& namespaces,
+                 std::ostream& out) {
+  out << "// Generated by jwks_embed from " << options.input
+      << ". Do not edit.\n\n"
+      << "#pragma once\n\n"
+      << "#include \"jwt_verify_lib/embedded_jwks.h\"\n\n";
+  for (absl::string_view ns : namespaces) {
+    out << "namespace " << ns << " {\n";
+  }
+  out << "\nextern const ::google::jwt_verify::EmbeddedJwks " << options.symbol
+      << ";\n\n";
+  for (auto it = namespaces.rbegin(); it != namespaces.rend(); ++it) {
+    out << "}  // namespace " << *it << "\n";
+  }
+}
+
+int run(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, &options)) {
+    std::cerr << "Usage: " << argv[0]
+              << " --type=jwks|pem --symbol=kKeys [--namespace=a::b]"
+                 " --include=path/to/out.h --out_h=out.h --out_cc=out.cc"
+                 " input\n";
+    return 2;
+  }
+
+  std::ifstream input(options.input, std::ios::binary);
+  if (!input) {
+    std::cerr << options.input << ": "
+              << getStatusString(Status::JwksFileReadError) << "\n";
+    return 1;
+  }
+  std::stringstream text;
+  text << input.rdbuf();
+  JwksPtr jwks = options.type == "pem"
+                     ? Jwks::createFromPemBundle(text.str())
+                     : Jwks::createFrom(text.str(), Jwks::JWKS);
+  if (jwks->getStatus() != Status::Ok) {
+    std::cerr << options.input << ": " << getStatusString(jwks->getStatus())
+              << "\n";
+    return 1;
+  }
+
+  const std::vector<absl::string_view> namespaces =
+      absl::StrSplit(options.ns, "::", absl::SkipEmpty());
+  std::ofstream out_cc(options.out_cc);
+  writeSource(options, *jwks, namespaces, out_cc);
+  std::ofstream out_h(options.out_h);
+  writeHeader(options, namespaces, out_h);
+  if (!out_cc || !out_h) {
+    std::cerr << "Failed to write " << options.out_cc << " or "
+              << options.out_h << "\n";
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
+
+int main(int argc, char** argv) {
+  return google::jwt_verify::run(argc, argv);
+}
@@ -0,0 +1,210 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/jwks_file_watcher.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/strings/match.h"
+#include "absl/time/clock.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+// The changes that may update the key file: in-place writes, and files
+// created or renamed into the directory.
+constexpr uint32_t kWatchMask =
+    IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_TO;
+
+bool readFile(const std::string& path, std::string* contents) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  contents->clear();
+  char buffer[16384];
+  ssize_t n;
+  while ((n = ::read(fd, buffer, sizeof(buffer))) != 0) {
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      close(fd);
+      return false;
+    }
+    contents->append(buffer, n);
+  }
+  close(fd);
+  return true;
+}
+
+void closeFd(int* fd) {
+  if (*fd >= 0) {
+    close(*fd);
+    *fd = -1;
+  }
+}
+
+}  // namespace
+
+JwksFileWatcher::JwksFileWatcher(const std::string& path,
+                                 const Options& options)
+    : path_(path), options_(options) {
+  const size_t slash = path_.rfind('/');
+  if (slash == std::string::npos) {
+    dir_ = ".";
+    name_ = path_;
+  } else {
+    dir_ = slash == 0 ? "/" : path_.substr(0, slash);
+    name_ = path_.substr(slash + 1);
+  }
+}
+
+JwksFileWatcher::~JwksFileWatcher() { stop(); }
+
+Status JwksFileWatcher::start() {
+  if (thread_.joinable()) {
+    return lastLoadStatus();
+  }
+  inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd_ < 0 ||
+      inotify_add_watch(inotify_fd_, dir_.c_str(), kWatchMask) < 0 ||
+      pipe2(stop_fds_, O_CLOEXEC) != 0) {
+    closeFd(&inotify_fd_);
+    return Status::JwksFileWatchFail;
+  }
+  // Changes made while the file is loaded are queued by inotify, so none is
+  // missed between this load and the start of the thread.
+  const Status status = reload();
+  thread_ = std::thread(&JwksFileWatcher::run, this);
+  return status;
+}
+
+void JwksFileWatcher::stop() {
+  if (!thread_.joinable()) {
+    return;
+  }
+  const char byte = 0;
+  while (::write(stop_fds_[1], &byte, 1) < 0 && errno == EINTR) {
+  }
+  thread_.join();
+  closeFd(&inotify_fd_);
+  closeFd(&stop_fds_[0]);
+  closeFd(&stop_fds_[1]);
+}
+
+std::shared_ptr<const Jwks> JwksFileWatcher::jwks() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return jwks_;
+}
+
+Status JwksFileWatcher::lastLoadStatus() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return last_status_;
+}
+
+uint64_t JwksFileWatcher::generation() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return generation_;
+}
+
+Status JwksFileWatcher::reload() {
+  // Read and parse without the lock, so that jwks() keeps serving the last
+  // good key set. A file caught in the middle of a write fails to parse and
+  // is not published; the write that completes it triggers another reload.
+  std::string text;
+  JwksPtr jwks;
+  Status status = Status::JwksFileReadError;
+  if (readFile(path_, &text)) {
+    jwks = Jwks::createFrom(text, options_.type, options_.load_options);
+    status = jwks->getStatus();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  last_status_ = status;
+  if (status == Status::Ok) {
+    jwks_ = std::move(jwks);
+    ++generation_;
+  }
+  return status;
+}
+
+bool JwksFileWatcher::readEvents() {
+  alignas(struct inotify_event) char buffer[4096];
+  bool changed = false;
+  ssize_t n;
+  while ((n = ::read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+    for (char* p = buffer; p < buffer + n;) {
+      const auto* event = reinterpret_cast<const struct inotify_event*>(p);
+      p += sizeof(struct inotify_event) + event->len;
+      if (event->mask & IN_Q_OVERFLOW) {
+        // Events were dropped, any of them may be about the file.
+        changed = true;
+        continue;
+      }
+      if (event->len == 0) {
+        continue;
+      }
+      const absl::string_view name = event->name;
+      // Kubernetes updates secret volumes by swapping the "..data" symlink
+      // the key file points through.
+      if (name == name_ || absl::StartsWith(name, "..")) {
+        changed = true;
+      }
+    }
+  }
+  return changed;
+}
+
+void JwksFileWatcher::run() {
+  bool pending = false;
+  absl::Time deadline;
+  while (true) {
+    int timeout_ms = -1;
+    if (pending) {
+      timeout_ms = static_cast<int>(std::max<int64_t>(
+          0, absl::ToInt64Milliseconds(
+                 absl::Ceil(deadline - absl::Now(), absl::Milliseconds(1)))));
+    }
+    struct pollfd fds[2] = {{inotify_fd_, POLLIN, 0},
+                            {stop_fds_[0], POLLIN, 0}};
+    if (poll(fds, 2, timeout_ms) < 0 && errno != EINTR) {
+      return;
+    }
+    if (fds[1].revents != 0) {
+      return;
+    }
+    if ((fds[0].revents & POLLIN) && readEvents()) {
+      // Every change pushes the reload back, so a burst of writes is
+      // parsed once.
+      pending = true;
+      deadline = absl::Now() + options_.debounce;
+    }
+    if (pending && absl::Now() >= deadline) {
+      pending = false;
+      reload();
+    }
+  }
+}
+
+}  // namespace jwt_verify
+}  // namespace google
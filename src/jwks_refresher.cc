@@ -0,0 +1,159 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/jwks_refresher.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace google {
+namespace jwt_verify {
+
+JwksRefresher::JwksRefresher(Fetcher fetcher, const Options& options)
+    : fetcher_(std::move(fetcher)),
+      options_(options),
+      backoff_(options.initial_backoff),
+      random_(std::random_device()()) {}
+
+JwksRefresher::~JwksRefresher() { stop(); }
+
+void JwksRefresher::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (thread_.joinable()) {
+    return;
+  }
+  stopping_ = false;
+  thread_ = std::thread(&JwksRefresher::run, this);
+}
+
+void JwksRefresher::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wakeup_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+std::shared_ptr<const Jwks> JwksRefresher::jwks() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return jwks_;
+}
+
+Status JwksRefresher::lastRefreshStatus() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return last_status_;
+}
+
+absl::Time JwksRefresher::nextRefreshTime() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return next_refresh_;
+}
+
+bool JwksRefresher::refreshIfDue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (refreshing_ || options_.clock() < next_refresh_) {
+      return false;
+    }
+    refreshing_ = true;
+  }
+  refresh();
+  return true;
+}
+
+bool JwksRefresher::onVerifyStatus(const Jwt& jwt, Status status) {
+  if (status != Status::JwksKidAlgMismatch || jwt.kid_.empty()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (jwks_ != nullptr) {
+    for (const auto& key : jwks_->keys()) {
+      if (key->kid_ == jwt.kid_) {
+        // The kid is known, so only its alg did not match. A refresh would
+        // not help.
+        return false;
+      }
+    }
+  }
+  const absl::Time now = options_.clock();
+  if (now - last_unknown_kid_refresh_ < options_.min_unknown_kid_interval) {
+    return false;
+  }
+  last_unknown_kid_refresh_ = now;
+  next_refresh_ = std::min(next_refresh_, now);
+  wakeup_.notify_all();
+  return true;
+}
+
+Status JwksRefresher::refresh() {
+  // Fetch and parse without the lock, so that jwks() keeps serving the last
+  // good key set.
+  std::string jwks_text;
+  Status status = fetcher_(&jwks_text);
+  JwksPtr jwks;
+  if (status == Status::Ok) {
+    jwks = Jwks::createFrom(jwks_text, options_.type, options_.load_options);
+    status = jwks->getStatus();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const absl::Time now = options_.clock();
+  refreshing_ = false;
+  last_status_ = status;
+  if (status == Status::Ok) {
+    jwks_ = std::move(jwks);
+    backoff_ = options_.initial_backoff;
+    next_refresh_ = now + jittered(options_.refresh_interval);
+  } else {
+    next_refresh_ = now + jittered(backoff_);
+    backoff_ = std::min(backoff_ * 2, options_.max_backoff);
+  }
+  wakeup_.notify_all();
+  return status;
+}
+
+absl::Duration JwksRefresher::jittered(absl::Duration interval) {
+  if (options_.jitter <= 0) {
+    return interval;
+  }
+  std::uniform_real_distribution<double> spread(-options_.jitter,
+                                                options_.jitter);
+  return interval * (1.0 + spread(random_));
+}
+
+void JwksRefresher::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_) {
+    if (refreshing_) {
+      // A refresh started by refreshIfDue() is in flight.
+      wakeup_.wait(lock);
+      continue;
+    }
+    const absl::Time now = options_.clock();
+    if (now < next_refresh_) {
+      wakeup_.wait_for(lock, absl::ToChronoNanoseconds(next_refresh_ - now));
+      continue;
+    }
+    refreshing_ = true;
+    lock.unlock();
+    refresh();
+    lock.lock();
+  }
+}
+
+}  // namespace jwt_verify
+}  // namespace google
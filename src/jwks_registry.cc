@@ -0,0 +1,131 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/jwks_registry.h"
+
+#include <utility>
+
+namespace google {
+namespace jwt_verify {
+
+JwksRegistry::Handle::Handle(Handle&& other)
+    : registry_(other.registry_),
+      issuer_(std::move(other.issuer_)),
+      jwks_(other.jwks_),
+      status_(other.status_) {
+  other.registry_ = nullptr;
+  other.jwks_ = nullptr;
+}
+
+JwksRegistry::Handle& JwksRegistry::Handle::operator=(Handle&& other) {
+  if (this != &other) {
+    reset();
+    registry_ = other.registry_;
+    issuer_ = std::move(other.issuer_);
+    jwks_ = other.jwks_;
+    status_ = other.status_;
+    other.registry_ = nullptr;
+    other.jwks_ = nullptr;
+  }
+  return *this;
+}
+
+JwksRegistry::Handle::~Handle() { reset(); }
+
+void JwksRegistry::Handle::reset() {
+  if (registry_ != nullptr && jwks_ != nullptr) {
+    registry_->release(issuer_, jwks_);
+  }
+  registry_ = nullptr;
+  jwks_ = nullptr;
+}
+
+JwksRegistry::JwksRegistry(Loader loader, int64_t max_bytes)
+    : loader_(std::move(loader)), cache_(max_bytes) {}
+
+JwksRegistry::~JwksRegistry() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.clear();
+}
+
+JwksRegistry::Handle JwksRegistry::lookup(const std::string& issuer) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  Jwks* jwks = cache_.lookup(issuer);
+  if (jwks != nullptr) {
+    return Handle(this, issuer, jwks);
+  }
+
+  // Join a load of the same issuer that is already in flight.
+  auto pending_it = pending_.find(issuer);
+  if (pending_it != pending_.end()) {
+    std::shared_ptr<PendingLoad> pending = pending_it->second;
+    ++pending->waiters;
+    load_done_.wait(lock, [&pending] { return pending->done; });
+    if (pending->jwks == nullptr) {
+      return Handle(pending->status);
+    }
+    // The loader pinned the key set once for every waiter.
+    return Handle(this, issuer, pending->jwks);
+  }
+
+  auto pending = std::make_shared<PendingLoad>();
+  pending_[issuer] = pending;
+  lock.unlock();
+
+  JwksPtr loaded = loader_(issuer);
+
+  lock.lock();
+  pending_.erase(issuer);
+  pending->done = true;
+  if (loaded == nullptr) {
+    pending->status = Status::JwksFetchFail;
+  } else if (loaded->getStatus() != Status::Ok) {
+    pending->status = loaded->getStatus();
+  } else {
+    pending->jwks = loaded.release();
+    cache_.insertPinned(issuer, pending->jwks, pending->jwks->memoryUsage());
+    for (int i = 0; i < pending->waiters; ++i) {
+      cache_.lookup(issuer);
+    }
+  }
+  load_done_.notify_all();
+
+  if (pending->jwks == nullptr) {
+    return Handle(pending->status);
+  }
+  return Handle(this, issuer, pending->jwks);
+}
+
+void JwksRegistry::remove(const std::string& issuer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.remove(issuer);
+}
+
+int64_t JwksRegistry::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.size();
+}
+
+int64_t JwksRegistry::entries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.entries();
+}
+
+void JwksRegistry::release(const std::string& issuer, Jwks* jwks) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.release(issuer, jwks);
+}
+
+}  // namespace jwt_verify
+}  // namespace google
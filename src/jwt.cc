@@ -15,12 +15,16 @@
 #include "jwt_verify_lib/jwt.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_split.h"
 #include "absl/time/clock.h"
 #include "google/protobuf/util/json_util.h"
+#include "jwt_verify_lib/claim_extractor.h"
+#include "jwt_verify_lib/json_reader.h"
+#include "jwt_verify_lib/jwks.h"
 #include "jwt_verify_lib/struct_utils.h"
 
 namespace google {
@@ -38,6 +42,162 @@ bool isImplemented(absl::string_view alg) {
   return implemented_algs.find(alg) != implemented_algs.end();
 }
 
+// Computes the RFC 7638 thumbprint of the "jwk" header. Returns empty if
+// there is no "jwk" header or it lacks a required member.
+std::string jwkHeaderThumbprint(const ::google::protobuf::Struct& header_pb) {
+  const auto& fields = header_pb.fields();
+  const auto jwk_it = fields.find("jwk");
+  if (jwk_it == fields.end() ||
+      jwk_it->second.kind_case() != ::google::protobuf::Value::kStructValue) {
+    return "";
+  }
+  StructUtils jwk_getter(jwk_it->second.struct_value());
+  std::string kty, crv, e, n, x, y;
+  jwk_getter.GetString("kty", &kty);
+  jwk_getter.GetString("crv", &crv);
+  jwk_getter.GetString("e", &e);
+  jwk_getter.GetString("n", &n);
+  jwk_getter.GetString("x", &x);
+  jwk_getter.GetString("y", &y);
+  bool complete = false;
+  if (kty == "RSA") {
+    complete = !e.empty() && !n.empty();
+  } else if (kty == "EC") {
+    complete = !crv.empty() && !x.empty() && !y.empty();
+  } else if (kty == "OKP") {
+    complete = !crv.empty() && !x.empty();
+  }
+  if (!complete) {
+    return "";
+  }
+  return Jwks::computeThumbprint({kty, crv, e, n, x, y});
+}
+
+// The result of looking up each header member that is checked.
+struct HeaderCodes {
+  StructUtils::FindResult alg = StructUtils::MISSING;
+  StructUtils::FindResult kid = StructUtils::MISSING;
+  StructUtils::FindResult x5t = StructUtils::MISSING;
+  StructUtils::FindResult x5t_s256 = StructUtils::MISSING;
+};
+
+enum class FlatHeader { Ok, BadJson, NotFlat };
+
+// Reads a string header member into value. A value of another type is
+// skipped, like StructUtils::GetString does.
+bool readHeaderString(JsonReader* reader, StructUtils::FindResult* code,
+                      std::string* value) {
+  if (reader->peek() != JsonReader::Type::String) {
+    *code = StructUtils::WRONG_TYPE;
+    return reader->skipValue();
+  }
+  *code = StructUtils::OK;
+  return reader->readString(value);
+}
+
+// Reads a header whose members all have scalar values, as most headers do,
+// straight into jwt without building a Struct. Returns NotFlat at the first
+// member that is an object or an array, such as "jwk".
+FlatHeader scanFlatHeader(absl::string_view header, Jwt* jwt,
+                          HeaderCodes* codes) {
+  JsonReader reader(header);
+  absl::string_view name;
+  if (reader.beginObject()) {
+    while (reader.nextMember(&name)) {
+      const JsonReader::Type type = reader.peek();
+      if (type == JsonReader::Type::Object || type == JsonReader::Type::Array) {
+        return FlatHeader::NotFlat;
+      }
+      bool read;
+      if (name == "alg") {
+        read = readHeaderString(&reader, &codes->alg, &jwt->alg_);
+      } else if (name == "kid") {
+        read = readHeaderString(&reader, &codes->kid, &jwt->kid_);
+      } else if (name == "typ") {
+        StructUtils::FindResult typ_code;
+        read = readHeaderString(&reader, &typ_code, &jwt->typ_);
+      } else if (name == "x5t") {
+        read = readHeaderString(&reader, &codes->x5t, &jwt->x5t_);
+      } else if (name == "x5t#S256") {
+        read = readHeaderString(&reader, &codes->x5t_s256, &jwt->x5t_s256_);
+      } else {
+        read = reader.skipValue();
+      }
+      if (!read) {
+        break;
+      }
+    }
+  }
+  return reader.done() ? FlatHeader::Ok : FlatHeader::BadJson;
+}
+
+// The registered claims read by parseFromString, in the order of
+// registeredClaims().
+enum RegisteredClaim {
+  kIss,
+  kSub,
+  kIat,
+  kNbf,
+  kExp,
+  kJti,
+  kAud,
+  kRegisteredClaimCount,
+};
+
+const ClaimExtractor& registeredClaims() {
+  static const ClaimExtractor* extractor = new ClaimExtractor({
+      {"iss", ClaimExtractor::Type::String},
+      {"sub", ClaimExtractor::Type::String},
+      {"iat", ClaimExtractor::Type::UInt64},
+      {"nbf", ClaimExtractor::Type::UInt64},
+      {"exp", ClaimExtractor::Type::UInt64},
+      {"jti", ClaimExtractor::Type::String},
+      {"aud", ClaimExtractor::Type::StringList},
+  });
+  return *extractor;
+}
+
+// Reads the header fields of jwt from its header in Struct protobuf.
+void readHeaderStruct(const ::google::protobuf::Struct& header_pb, Jwt* jwt,
+                      HeaderCodes* codes) {
+  StructUtils header_getter(header_pb);
+  codes->alg = header_getter.GetString("alg", &jwt->alg_);
+  codes->kid = header_getter.GetString("kid", &jwt->kid_);
+  header_getter.GetString("typ", &jwt->typ_);
+  codes->x5t = header_getter.GetString("x5t", &jwt->x5t_);
+  codes->x5t_s256 = header_getter.GetString("x5t#S256", &jwt->x5t_s256_);
+  jwt->jwk_thumbprint_ = jwkHeaderThumbprint(header_pb);
+}
+
+// Parses json into struct_pb, leaving it empty if json is not an object.
+void parseStruct(const std::string& json,
+                 ::google::protobuf::Struct* struct_pb) {
+  ::google::protobuf::util::JsonParseOptions options;
+  if (!::google::protobuf::util::JsonStringToMessage(json, struct_pb, options)
+           .ok()) {
+    struct_pb->Clear();
+  }
+}
+
+void clearHeaderFields(Jwt* jwt) {
+  jwt->alg_.clear();
+  jwt->kid_.clear();
+  jwt->typ_.clear();
+  jwt->x5t_.clear();
+  jwt->x5t_s256_.clear();
+  jwt->jwk_thumbprint_.clear();
+}
+
+void clearPayloadFields(Jwt* jwt) {
+  jwt->iss_.clear();
+  jwt->audiences_.clear();
+  jwt->sub_.clear();
+  jwt->iat_ = 0;
+  jwt->nbf_ = 0;
+  jwt->exp_ = 0;
+  jwt->jti_.clear();
+}
+
 }  // namespace
 
 Jwt::Jwt(const Jwt& instance) { *this = instance; }
@@ -48,6 +208,22 @@ Jwt& Jwt::operator=(const Jwt& rhs) {
 }
 
 Status Jwt::parseFromString(const std::string& jwt) {
+  // Forget the previous token first, so that a failed parse leaves no state
+  // of it, nor claims referring to its payload.
+  header_str_base64url_.clear();
+  header_str_.clear();
+  header_pb_.Clear();
+  header_pb_parsed_ = false;
+  clearHeaderFields(this);
+  payload_str_base64url_.clear();
+  payload_str_.clear();
+  payload_pb_.Clear();
+  payload_pb_parsed_ = false;
+  payload_claims_.clear();
+  claims_base64url_.clear();
+  clearPayloadFields(this);
+  signature_.clear();
+
   // jwt must have exactly 2 dots with 3 sections.
   jwt_ = jwt;
   std::vector<absl::string_view> jwt_split =
@@ -62,16 +238,29 @@ Status Jwt::parseFromString(const std::string& jwt) {
     return Status::JwtHeaderParseErrorBadBase64;
   }
 
+  HeaderCodes header_codes;
   ::google::protobuf::util::JsonParseOptions options;
-  const auto header_status = ::google::protobuf::util::JsonStringToMessage(
-      header_str_, &header_pb_, options);
-  if (!header_status.ok()) {
-    return Status::JwtHeaderParseErrorBadJson;
+  switch (scanFlatHeader(header_str_, this, &header_codes)) {
+    case FlatHeader::Ok:
+      break;
+    case FlatHeader::BadJson:
+      return Status::JwtHeaderParseErrorBadJson;
+    case FlatHeader::NotFlat: {
+      // Fall back to the general parser.
+      clearHeaderFields(this);
+      const auto header_status = ::google::protobuf::util::JsonStringToMessage(
+          header_str_, &header_pb_, options);
+      if (!header_status.ok()) {
+        return Status::JwtHeaderParseErrorBadJson;
+      }
+      header_pb_parsed_ = true;
+      readHeaderStruct(header_pb_, this, &header_codes);
+      break;
+    }
   }
 
-  StructUtils header_getter(header_pb_);
   // Header should contain "alg" and should be a string.
-  if (header_getter.GetString("alg", &alg_) != StructUtils::OK) {
+  if (header_codes.alg != StructUtils::OK) {
     return Status::JwtHeaderBadAlg;
   }
 
@@ -80,62 +269,68 @@ Status Jwt::parseFromString(const std::string& jwt) {
   }
 
   // Header may contain "kid", should be a string if exists.
-  if (header_getter.GetString("kid", &kid_) == StructUtils::WRONG_TYPE) {
+  if (header_codes.kid == StructUtils::WRONG_TYPE) {
     return Status::JwtHeaderBadKid;
   }
 
+  // Header may contain "x5t" and "x5t#S256", should be strings if exist.
+  if (header_codes.x5t == StructUtils::WRONG_TYPE ||
+      header_codes.x5t_s256 == StructUtils::WRONG_TYPE) {
+    return Status::JwtHeaderBadX5t;
+  }
+
   // Parse payload json
   payload_str_base64url_ = std::string(jwt_split[1]);
   if (!absl::WebSafeBase64Unescape(payload_str_base64url_, &payload_str_)) {
     return Status::JwtPayloadParseErrorBadBase64;
   }
 
-  const auto payload_status = ::google::protobuf::util::JsonStringToMessage(
-      payload_str_, &payload_pb_, options);
-  if (!payload_status.ok()) {
+  if (!payload_claims_.parse(payload_str_)) {
     return Status::JwtPayloadParseErrorBadJson;
   }
 
-  StructUtils payload_getter(payload_pb_);
-  if (payload_getter.GetString("iss", &iss_) == StructUtils::WRONG_TYPE) {
+  ClaimExtractor::Result claims[kRegisteredClaimCount];
+  registeredClaims().extract(payload_claims_, claims);
+  if (claims[kIss].code == StructUtils::WRONG_TYPE) {
     return Status::JwtPayloadParseErrorIssNotString;
   }
-  if (payload_getter.GetString("sub", &sub_) == StructUtils::WRONG_TYPE) {
+  iss_ = std::string(claims[kIss].string_value);
+  if (claims[kSub].code == StructUtils::WRONG_TYPE) {
     return Status::JwtPayloadParseErrorSubNotString;
   }
+  sub_ = std::string(claims[kSub].string_value);
 
-  auto result = payload_getter.GetUInt64("iat", &iat_);
-  if (result == StructUtils::WRONG_TYPE) {
+  if (claims[kIat].code == StructUtils::WRONG_TYPE) {
     return Status::JwtPayloadParseErrorIatNotInteger;
-  } else if (result == StructUtils::OUT_OF_RANGE) {
+  } else if (claims[kIat].code == StructUtils::OUT_OF_RANGE) {
     return Status::JwtPayloadParseErrorIatOutOfRange;
   }
+  iat_ = claims[kIat].uint64_value;
 
-  result = payload_getter.GetUInt64("nbf", &nbf_);
-  if (result == StructUtils::WRONG_TYPE) {
+  if (claims[kNbf].code == StructUtils::WRONG_TYPE) {
     return Status::JwtPayloadParseErrorNbfNotInteger;
-  } else if (result == StructUtils::OUT_OF_RANGE) {
+  } else if (claims[kNbf].code == StructUtils::OUT_OF_RANGE) {
     return Status::JwtPayloadParseErrorNbfOutOfRange;
   }
+  nbf_ = claims[kNbf].uint64_value;
 
-  result = payload_getter.GetUInt64("exp", &exp_);
-  if (result == StructUtils::WRONG_TYPE) {
+  if (claims[kExp].code == StructUtils::WRONG_TYPE) {
     return Status::JwtPayloadParseErrorExpNotInteger;
-  } else if (result == StructUtils::OUT_OF_RANGE) {
+  } else if (claims[kExp].code == StructUtils::OUT_OF_RANGE) {
     return Status::JwtPayloadParseErrorExpOutOfRange;
   }
+  exp_ = claims[kExp].uint64_value;
 
-  if (payload_getter.GetString("jti", &jti_) == StructUtils::WRONG_TYPE) {
+  if (claims[kJti].code == StructUtils::WRONG_TYPE) {
     return Status::JwtPayloadParseErrorJtiNotString;
   }
+  jti_ = std::string(claims[kJti].string_value);
 
   // "aud" can be either string array or string.
-  // GetStringList function will try to read as string, if fails,
-  // try to read as string array.
-  if (payload_getter.GetStringList("aud", &audiences_) ==
-      StructUtils::WRONG_TYPE) {
+  if (claims[kAud].code == StructUtils::WRONG_TYPE) {
     return Status::JwtPayloadParseErrorAudNotString;
   }
+  audiences_ = std::move(claims[kAud].string_list);
 
   // Set up signature
   if (!absl::WebSafeBase64Unescape(jwt_split[2], &signature_)) {
@@ -145,13 +340,67 @@ Status Jwt::parseFromString(const std::string& jwt) {
   return Status::Ok;
 }
 
+const ::google::protobuf::Struct& Jwt::headerPb() const {
+  if (!header_pb_parsed_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(lazy_mutex_);
+    if (!header_pb_parsed_.load(std::memory_order_relaxed)) {
+      parseStruct(header_str_, &header_pb_);
+      header_pb_parsed_.store(true, std::memory_order_release);
+    }
+  }
+  return header_pb_;
+}
+
+const ::google::protobuf::Struct& Jwt::payloadPb() const {
+  if (!payload_pb_parsed_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(lazy_mutex_);
+    if (!payload_pb_parsed_.load(std::memory_order_relaxed)) {
+      parseStruct(payload_str_, &payload_pb_);
+      payload_pb_parsed_.store(true, std::memory_order_release);
+    }
+  }
+  return payload_pb_;
+}
+
+StructUtils::FindResult Jwt::appendClaim(const ClaimPath& path,
+                                         std::string* out) const {
+  const JwtClaims::Claim* claim;
+  const auto result = payload_claims_.GetValue(path, claim);
+  if (result == StructUtils::OK) {
+    out->append(claim->value.data(), claim->value.size());
+  }
+  return result;
+}
+
+StructUtils::FindResult Jwt::claimBase64url(const ClaimPath& path,
+                                            absl::string_view* encoded) const {
+  std::lock_guard<std::mutex> lock(lazy_mutex_);
+  const auto it = claims_base64url_.find(path.path());
+  if (it != claims_base64url_.end()) {
+    *encoded = *it->second;
+    return StructUtils::OK;
+  }
+  const JwtClaims::Claim* claim;
+  const auto result = payload_claims_.GetValue(path, claim);
+  if (result != StructUtils::OK) {
+    return result;
+  }
+  // Held by pointer, so views stay valid as the map grows.
+  std::unique_ptr<std::string> value(new std::string());
+  absl::WebSafeBase64Escape(claim->value, value.get());
+  *encoded = *value;
+  claims_base64url_.emplace(path.path(), std::move(value));
+  return StructUtils::OK;
+}
+
 Status Jwt::verifyTimeConstraint(uint64_t now, uint64_t clock_skew) const {
-  // Check Jwt is active (nbf).
-  if (now + clock_skew < nbf_) {
+  // Check Jwt is active (nbf). Times are exact up to 2^64 - 1, so compare
+  // differences to not overflow.
+  if (nbf_ > now && nbf_ - now > clock_skew) {
     return Status::JwtNotYetValid;
   }
   // Check JWT has not expired (exp).
-  if (exp_ && now > exp_ + clock_skew) {
+  if (exp_ && now > exp_ && now - exp_ > clock_skew) {
     return Status::JwtExpired;
   }
   return Status::Ok;
@@ -0,0 +1,505 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/jwt_claims.h"
+
+#include <algorithm>
+#include <limits>
+#include <system_error>
+
+#include "absl/strings/charconv.h"
+#include "absl/strings/str_split.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+// Reads the integer part of a JSON number, which JsonReader has checked,
+// e.g. 1500 for "1.5e3". Sets negative if the number is below zero, even if
+// its integer part is zero, e.g. for "-0.5". Returns false if the magnitude
+// of the integer part does not fit 64 bits.
+bool parseIntegerPart(absl::string_view number, bool* negative,
+                      uint64_t* magnitude) {
+  const absl::string_view text = number;
+  const bool has_sign = !number.empty() && number[0] == '-';
+  if (has_sign) {
+    number.remove_prefix(1);
+  }
+  // Split into the digits and the exponent of the number they stand for,
+  // e.g. "15" and 2 for "1.5e3".
+  const size_t exponent_pos = number.find_first_of("eE");
+  int64_t exponent = 0;
+  if (exponent_pos != absl::string_view::npos) {
+    absl::string_view exponent_text = number.substr(exponent_pos + 1);
+    const bool negative_exponent = exponent_text[0] == '-';
+    if (exponent_text[0] == '-' || exponent_text[0] == '+') {
+      exponent_text.remove_prefix(1);
+    }
+    for (char c : exponent_text) {
+      // Any exponent past the digits of a uint64 is as good as the next.
+      exponent = std::min<int64_t>(exponent * 10 + (c - '0'), 100000);
+    }
+    if (negative_exponent) {
+      exponent = -exponent;
+    }
+    number = number.substr(0, exponent_pos);
+  }
+  if (number.find_first_of("123456789") == absl::string_view::npos) {
+    *negative = false;
+    *magnitude = 0;
+    return true;
+  }
+  const size_t point = number.find('.');
+  const absl::string_view int_digits = number.substr(0, point);
+  const absl::string_view fraction_digits =
+      point == absl::string_view::npos ? absl::string_view()
+                                       : number.substr(point + 1);
+
+  // The digits before the decimal point once the exponent is applied; the
+  // others are dropped.
+  const int64_t kept = static_cast<int64_t>(int_digits.size()) + exponent;
+  uint64_t value = 0;
+  for (int64_t i = 0; i < kept; ++i) {
+    const size_t pos = static_cast<size_t>(i);
+    char c = '0';
+    if (pos < int_digits.size()) {
+      c = int_digits[pos];
+    } else if (pos - int_digits.size() < fraction_digits.size()) {
+      c = fraction_digits[pos - int_digits.size()];
+    }
+    const uint64_t digit = c - '0';
+    if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  *magnitude = value;
+  *negative = has_sign;
+  if (has_sign && value == 0) {
+    // A number such as -1e-400 is -0 as a double, which is not below zero.
+    double double_value;
+    const auto parsed = absl::from_chars(text.data(), text.data() + text.size(),
+                                         double_value);
+    *negative = parsed.ec != std::errc::result_out_of_range;
+  }
+  return true;
+}
+
+}  // namespace
+
+void JwtClaims::clear() {
+  claims_.clear();
+  decoded_.clear();
+  nested_.clear();
+  string_sets_.clear();
+}
+
+bool JwtClaims::parse(absl::string_view json) {
+  clear();
+
+  // Views that are not of json, because of escapes, are copied to decoded_.
+  const auto keep = [&](absl::string_view view) -> absl::string_view {
+    if (view.data() >= json.data() &&
+        view.data() + view.size() <= json.data() + json.size()) {
+      return view;
+    }
+    decoded_.emplace_back(view);
+    return decoded_.back();
+  };
+
+  JsonReader reader(json);
+  absl::string_view name;
+  std::string buffer;
+  if (reader.beginObject()) {
+    while (reader.nextMember(&name)) {
+      Claim claim;
+      claim.name = keep(name);
+      claim.type = reader.peek();
+      if (claim.type == JsonReader::Type::String) {
+        if (!reader.readString(&claim.value, &buffer)) {
+          break;
+        }
+        claim.value = keep(claim.value);
+      } else {
+        const size_t start = reader.offset();
+        if (!reader.skipValue()) {
+          break;
+        }
+        claim.value = json.substr(start, reader.offset() - start);
+      }
+      claims_.push_back(claim);
+    }
+  }
+  if (!reader.done()) {
+    claims_.clear();
+    decoded_.clear();
+    return false;
+  }
+  return true;
+}
+
+template <typename Names>
+JwtClaims::FindResult JwtClaims::lookup(const Names& names,
+                                        const JwtClaims** owner,
+                                        size_t* index) const {
+  const JwtClaims* current = this;
+  const JwtClaims* found_owner = nullptr;
+  size_t found = 0;
+  for (absl::string_view name : names) {
+    if (found_owner != nullptr) {
+      if (found_owner->claims_[found].type != JsonReader::Type::Object) {
+        return StructUtils::WRONG_TYPE;
+      }
+      current = &found_owner->nested(found);
+    }
+    // Payloads have few members, a scan is faster than hashing their names.
+    size_t i = 0;
+    while (i < current->claims_.size() && current->claims_[i].name != name) {
+      ++i;
+    }
+    if (i == current->claims_.size()) {
+      return StructUtils::MISSING;
+    }
+    found_owner = current;
+    found = i;
+  }
+  *owner = found_owner;
+  *index = found;
+  return StructUtils::OK;
+}
+
+const JwtClaims& JwtClaims::nested(size_t i) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (nested_.size() < claims_.size()) {
+    nested_.resize(claims_.size());
+  }
+  if (nested_[i] == nullptr) {
+    nested_[i].reset(new JwtClaims());
+    // The whole text was checked by parse(), so this can not fail.
+    nested_[i]->parse(claims_[i].value);
+  }
+  return *nested_[i];
+}
+
+const JwtClaims::StringSet& JwtClaims::stringSet(size_t i) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (string_sets_.size() < claims_.size()) {
+    string_sets_.resize(claims_.size());
+  }
+  if (string_sets_[i] != nullptr) {
+    return *string_sets_[i];
+  }
+  string_sets_[i].reset(new StringSet());
+  StringSet& set = *string_sets_[i];
+  const Claim& claim = claims_[i];
+  if (claim.type == JsonReader::Type::String) {
+    set.values.insert(claim.value);
+    return set;
+  }
+  if (claim.type != JsonReader::Type::Array) {
+    set.result = StructUtils::WRONG_TYPE;
+    return set;
+  }
+  JsonReader reader(claim.value);
+  reader.beginArray();
+  absl::string_view value;
+  std::string buffer;
+  while (reader.nextElement()) {
+    if (reader.peek() != JsonReader::Type::String) {
+      set.result = StructUtils::WRONG_TYPE;
+      set.values.clear();
+      set.decoded.clear();
+      break;
+    }
+    reader.readString(&value, &buffer);
+    if (value.data() == buffer.data()) {
+      // It had escapes, and was decoded into buffer.
+      set.decoded.emplace_back(value);
+      value = set.decoded.back();
+    }
+    set.values.insert(value);
+  }
+  return set;
+}
+
+JwtClaims::FindResult JwtClaims::GetValue(absl::string_view nested_names,
+                                          const Claim*& found) const {
+  const JwtClaims* owner;
+  size_t index;
+  const FindResult result =
+      lookup(absl::StrSplit(nested_names, '.'), &owner, &index);
+  if (result == StructUtils::OK) {
+    found = &owner->claims_[index];
+  }
+  return result;
+}
+
+JwtClaims::FindResult JwtClaims::GetValue(const ClaimPath& path,
+                                          const Claim*& found) const {
+  const JwtClaims* owner;
+  size_t index;
+  const FindResult result = lookup(path.names(), &owner, &index);
+  if (result == StructUtils::OK) {
+    found = &owner->claims_[index];
+  }
+  return result;
+}
+
+template <typename Names>
+JwtClaims::FindResult JwtClaims::lookupObject(const Names& names,
+                                              const JwtClaims*& found) const {
+  const JwtClaims* owner;
+  size_t index;
+  const FindResult result = lookup(names, &owner, &index);
+  if (result != StructUtils::OK) {
+    return result;
+  }
+  if (owner->claims_[index].type != JsonReader::Type::Object) {
+    return StructUtils::WRONG_TYPE;
+  }
+  found = &owner->nested(index);
+  return StructUtils::OK;
+}
+
+JwtClaims::FindResult JwtClaims::GetObject(absl::string_view nested_names,
+                                           const JwtClaims*& found) const {
+  return lookupObject(absl::StrSplit(nested_names, '.'), found);
+}
+
+JwtClaims::FindResult JwtClaims::GetObject(const ClaimPath& path,
+                                           const JwtClaims*& found) const {
+  return lookupObject(path.names(), found);
+}
+
+template <typename Names>
+JwtClaims::FindResult JwtClaims::lookupContains(const Names& names,
+                                                absl::string_view value,
+                                                bool* contained) const {
+  const JwtClaims* owner;
+  size_t index;
+  const FindResult result = lookup(names, &owner, &index);
+  if (result != StructUtils::OK) {
+    return result;
+  }
+  const StringSet& set = owner->stringSet(index);
+  if (set.result == StructUtils::OK) {
+    *contained = set.values.contains(value);
+  }
+  return set.result;
+}
+
+JwtClaims::FindResult JwtClaims::Contains(absl::string_view name,
+                                          absl::string_view value,
+                                          bool* contained) const {
+  return lookupContains(absl::StrSplit(name, '.'), value, contained);
+}
+
+JwtClaims::FindResult JwtClaims::Contains(const ClaimPath& path,
+                                          absl::string_view value,
+                                          bool* contained) const {
+  return lookupContains(path.names(), value, contained);
+}
+
+JwtClaims::FindResult JwtClaims::ToObject(const Claim& claim,
+                                          const JwtClaims*& found) const {
+  if (claim.type != JsonReader::Type::Object) {
+    return StructUtils::WRONG_TYPE;
+  }
+  found = &nested(&claim - claims_.data());
+  return StructUtils::OK;
+}
+
+JwtClaims::FindResult JwtClaims::ToString(const Claim& claim,
+                                          absl::string_view* str_value) {
+  if (claim.type != JsonReader::Type::String) {
+    return StructUtils::WRONG_TYPE;
+  }
+  *str_value = claim.value;
+  return StructUtils::OK;
+}
+
+JwtClaims::FindResult JwtClaims::ToString(const Claim& claim,
+                                          std::string* str_value) {
+  absl::string_view value;
+  const FindResult result = ToString(claim, &value);
+  if (result == StructUtils::OK) {
+    str_value->assign(value.data(), value.size());
+  }
+  return result;
+}
+
+JwtClaims::FindResult JwtClaims::ToDouble(const Claim& claim,
+                                          double* double_value) {
+  if (claim.type != JsonReader::Type::Number) {
+    return StructUtils::WRONG_TYPE;
+  }
+  double value;
+  const auto parsed = absl::from_chars(
+      claim.value.data(), claim.value.data() + claim.value.size(), value);
+  // parse() rejected overflows, so out of range is an underflow to zero.
+  *double_value = parsed.ec == std::errc::result_out_of_range ? 0 : value;
+  return StructUtils::OK;
+}
+
+JwtClaims::FindResult JwtClaims::ToUInt64(const Claim& claim,
+                                          uint64_t* int_value) {
+  if (claim.type != JsonReader::Type::Number) {
+    return StructUtils::WRONG_TYPE;
+  }
+  bool negative;
+  uint64_t magnitude;
+  // Like StructUtils, any number below zero is out of range, e.g. -0.5.
+  if (!parseIntegerPart(claim.value, &negative, &magnitude) || negative) {
+    return StructUtils::OUT_OF_RANGE;
+  }
+  *int_value = magnitude;
+  return StructUtils::OK;
+}
+
+JwtClaims::FindResult JwtClaims::ToInt64(const Claim& claim,
+                                         int64_t* int_value) {
+  if (claim.type != JsonReader::Type::Number) {
+    return StructUtils::WRONG_TYPE;
+  }
+  bool negative;
+  uint64_t magnitude;
+  const uint64_t max = std::numeric_limits<int64_t>::max();
+  if (!parseIntegerPart(claim.value, &negative, &magnitude) ||
+      magnitude > max + (negative ? 1 : 0)) {
+    return StructUtils::OUT_OF_RANGE;
+  }
+  *int_value = negative ? static_cast<int64_t>(0 - magnitude)
+                        : static_cast<int64_t>(magnitude);
+  return StructUtils::OK;
+}
+
+JwtClaims::FindResult JwtClaims::ToBoolean(const Claim& claim,
+                                           bool* bool_value) {
+  if (claim.type != JsonReader::Type::Bool) {
+    return StructUtils::WRONG_TYPE;
+  }
+  *bool_value = claim.value == "true";
+  return StructUtils::OK;
+}
+
+JwtClaims::FindResult JwtClaims::ToStringList(const Claim& claim,
+                                              std::vector<std::string>* list) {
+  if (claim.type == JsonReader::Type::String) {
+    list->emplace_back(claim.value);
+    return StructUtils::OK;
+  }
+  if (claim.type != JsonReader::Type::Array) {
+    return StructUtils::WRONG_TYPE;
+  }
+  JsonReader reader(claim.value);
+  reader.beginArray();
+  while (reader.nextElement()) {
+    if (reader.peek() != JsonReader::Type::String) {
+      return StructUtils::WRONG_TYPE;
+    }
+    list->emplace_back();
+    reader.readString(&list->back());
+  }
+  return StructUtils::OK;
+}
+
+namespace {
+
+// Finds the claim at name or path, and converts it.
+template <typename Name, typename T>
+JwtClaims::FindResult getAs(
+    const JwtClaims& claims, const Name& name,
+    JwtClaims::FindResult (*convert)(const JwtClaims::Claim&, T*), T* value) {
+  const JwtClaims::Claim* found;
+  const JwtClaims::FindResult result = claims.GetValue(name, found);
+  if (result != StructUtils::OK) {
+    return result;
+  }
+  return convert(*found, value);
+}
+
+}  // namespace
+
+JwtClaims::FindResult JwtClaims::GetString(absl::string_view name,
+                                           absl::string_view* str_value) const {
+  return getAs(*this, name, ToString, str_value);
+}
+
+JwtClaims::FindResult JwtClaims::GetString(const ClaimPath& path,
+                                           absl::string_view* str_value) const {
+  return getAs(*this, path, ToString, str_value);
+}
+
+JwtClaims::FindResult JwtClaims::GetString(absl::string_view name,
+                                           std::string* str_value) const {
+  return getAs(*this, name, ToString, str_value);
+}
+
+JwtClaims::FindResult JwtClaims::GetString(const ClaimPath& path,
+                                           std::string* str_value) const {
+  return getAs(*this, path, ToString, str_value);
+}
+
+JwtClaims::FindResult JwtClaims::GetUInt64(absl::string_view name,
+                                           uint64_t* int_value) const {
+  return getAs(*this, name, ToUInt64, int_value);
+}
+
+JwtClaims::FindResult JwtClaims::GetUInt64(const ClaimPath& path,
+                                           uint64_t* int_value) const {
+  return getAs(*this, path, ToUInt64, int_value);
+}
+
+JwtClaims::FindResult JwtClaims::GetInt64(absl::string_view name,
+                                          int64_t* int_value) const {
+  return getAs(*this, name, ToInt64, int_value);
+}
+
+JwtClaims::FindResult JwtClaims::GetInt64(const ClaimPath& path,
+                                          int64_t* int_value) const {
+  return getAs(*this, path, ToInt64, int_value);
+}
+
+JwtClaims::FindResult JwtClaims::GetDouble(absl::string_view name,
+                                           double* double_value) const {
+  return getAs(*this, name, ToDouble, double_value);
+}
+
+JwtClaims::FindResult JwtClaims::GetDouble(const ClaimPath& path,
+                                           double* double_value) const {
+  return getAs(*this, path, ToDouble, double_value);
+}
+
+JwtClaims::FindResult JwtClaims::GetBoolean(absl::string_view name,
+                                            bool* bool_value) const {
+  return getAs(*this, name, ToBoolean, bool_value);
+}
+
+JwtClaims::FindResult JwtClaims::GetBoolean(const ClaimPath& path,
+                                            bool* bool_value) const {
+  return getAs(*this, path, ToBoolean, bool_value);
+}
+
+JwtClaims::FindResult JwtClaims::GetStringList(
+    absl::string_view name, std::vector<std::string>* list) const {
+  return getAs(*this, name, ToStringList, list);
+}
+
+JwtClaims::FindResult JwtClaims::GetStringList(
+    const ClaimPath& path, std::vector<std::string>* list) const {
+  return getAs(*this, path, ToStringList, list);
+}
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,193 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/key_intern_table.h"
+
+#include <utility>
+
+#include "openssl/sha.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+// Appends a length-prefixed big-endian big number.
+void appendBigNum(const BIGNUM* bn, std::string* out) {
+  const size_t len = BN_num_bytes(bn);
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    out->push_back(static_cast<char>((len >> shift) & 0xff));
+  }
+  const size_t pos = out->size();
+  out->resize(pos + len);
+  BN_bn2bin(bn, reinterpret_cast<uint8_t*>(&(*out)[pos]));
+}
+
+std::string sha256(const std::string& data) {
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  SHA256(reinterpret_cast<const uint8_t*>(data.data()), data.size(), digest);
+  return std::string(reinterpret_cast<const char*>(digest), sizeof(digest));
+}
+
+std::string ecThumbprint(int nid, const BIGNUM* x, const BIGNUM* y) {
+  std::string material = "EC" + std::to_string(nid);
+  appendBigNum(x, &material);
+  appendBigNum(y, &material);
+  return sha256(material);
+}
+
+}  // namespace
+
+KeyInternTable& KeyInternTable::global() {
+  static KeyInternTable* table = new KeyInternTable();
+  return *table;
+}
+
+KeyInternTable::KeyInternTable() : cache_(0) {}
+
+KeyInternTable::~KeyInternTable() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.clear();
+}
+
+void KeyInternTable::setMaxEntries(int64_t max_entries) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_entries_ = max_entries;
+  cache_.setMaxSize(max_entries);
+}
+
+bool KeyInternTable::enabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_entries_ > 0;
+}
+
+int64_t KeyInternTable::entries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.entries();
+}
+
+std::string KeyInternTable::rsaThumbprint(const BIGNUM* n, const BIGNUM* e) {
+  std::string material = "RSA";
+  appendBigNum(n, &material);
+  appendBigNum(e, &material);
+  return sha256(material);
+}
+
+bssl::UniquePtr<RSA> KeyInternTable::findCheckedRsa(
+    const std::string& thumbprint) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  InternedKey* found = cache_.lookup(thumbprint);
+  if (found == nullptr) {
+    return nullptr;
+  }
+  bssl::UniquePtr<RSA> rsa;
+  if (found->rsa_checked) {
+    RSA_up_ref(found->rsa.get());
+    rsa.reset(found->rsa.get());
+  }
+  cache_.release(thumbprint, found);
+  return rsa;
+}
+
+bssl::UniquePtr<EC_KEY> KeyInternTable::findEcKey(int nid, const BIGNUM* x,
+                                                  const BIGNUM* y) {
+  if (!enabled()) {
+    return nullptr;
+  }
+  const std::string thumbprint = ecThumbprint(nid, x, y);
+  std::lock_guard<std::mutex> lock(mutex_);
+  InternedKey* found = cache_.lookup(thumbprint);
+  if (found == nullptr) {
+    return nullptr;
+  }
+  EC_KEY_up_ref(found->ec_key.get());
+  bssl::UniquePtr<EC_KEY> ec_key(found->ec_key.get());
+  cache_.release(thumbprint, found);
+  return ec_key;
+}
+
+bssl::UniquePtr<RSA> KeyInternTable::intern(bssl::UniquePtr<RSA> rsa) {
+  if (rsa == nullptr || !enabled()) {
+    return rsa;
+  }
+  const BIGNUM* n;
+  const BIGNUM* e;
+  RSA_get0_key(rsa.get(), &n, &e, nullptr);
+  if (n == nullptr || e == nullptr) {
+    return rsa;
+  }
+  return internRsa(std::move(rsa), rsaThumbprint(n, e), /*checked=*/false);
+}
+
+bssl::UniquePtr<RSA> KeyInternTable::internChecked(
+    bssl::UniquePtr<RSA> rsa, const std::string& thumbprint) {
+  if (rsa == nullptr || !enabled()) {
+    return rsa;
+  }
+  return internRsa(std::move(rsa), thumbprint, /*checked=*/true);
+}
+
+bssl::UniquePtr<RSA> KeyInternTable::internRsa(bssl::UniquePtr<RSA> rsa,
+                                               const std::string& thumbprint,
+                                               bool checked) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  InternedKey* found = cache_.lookup(thumbprint);
+  if (found != nullptr) {
+    // The material is the same, so the interned key passed the check too.
+    found->rsa_checked = found->rsa_checked || checked;
+    RSA_up_ref(found->rsa.get());
+    rsa.reset(found->rsa.get());
+    cache_.release(thumbprint, found);
+    return rsa;
+  }
+  InternedKey* interned = new InternedKey();
+  RSA_up_ref(rsa.get());
+  interned->rsa.reset(rsa.get());
+  interned->rsa_checked = checked;
+  cache_.insert(thumbprint, interned, 1);
+  return rsa;
+}
+
+bssl::UniquePtr<EC_KEY> KeyInternTable::intern(bssl::UniquePtr<EC_KEY> ec_key) {
+  if (ec_key == nullptr || !enabled()) {
+    return ec_key;
+  }
+  const EC_GROUP* group = EC_KEY_get0_group(ec_key.get());
+  const EC_POINT* point = EC_KEY_get0_public_key(ec_key.get());
+  bssl::UniquePtr<BIGNUM> x(BN_new());
+  bssl::UniquePtr<BIGNUM> y(BN_new());
+  if (group == nullptr || point == nullptr || x == nullptr || y == nullptr ||
+      !EC_POINT_get_affine_coordinates_GFp(group, point, x.get(), y.get(),
+                                           nullptr)) {
+    return ec_key;
+  }
+  const std::string thumbprint =
+      ecThumbprint(EC_GROUP_get_curve_name(group), x.get(), y.get());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  InternedKey* found = cache_.lookup(thumbprint);
+  if (found != nullptr) {
+    EC_KEY_up_ref(found->ec_key.get());
+    ec_key.reset(found->ec_key.get());
+    cache_.release(thumbprint, found);
+    return ec_key;
+  }
+  InternedKey* interned = new InternedKey();
+  EC_KEY_up_ref(ec_key.get());
+  interned->ec_key.reset(ec_key.get());
+  cache_.insert(thumbprint, interned, 1);
+  return ec_key;
+}
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,113 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/scope_matcher.h"
+
+#include "absl/strings/str_split.h"
+
+namespace google {
+namespace jwt_verify {
+
+bool ScopeMatcher::Scopes::hasAll(const Scopes& required) const {
+  for (size_t i = 0; i < required.words_.size(); ++i) {
+    const uint64_t word = i < words_.size() ? words_[i] : 0;
+    if (required.words_[i] & ~word) {
+      return false;
+    }
+  }
+  // A required scope that is not in the vocabulary is never met.
+  return required.unknown_ == 0;
+}
+
+bool ScopeMatcher::Scopes::hasAny(const Scopes& wanted) const {
+  for (size_t i = 0; i < wanted.words_.size() && i < words_.size(); ++i) {
+    if (wanted.words_[i] & words_[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+ScopeMatcher::ScopeMatcher(const std::vector<std::string>& vocabulary,
+                           absl::string_view nested_names)
+    : claim_(nested_names) {
+  for (const std::string& scope : vocabulary) {
+    indexes_.emplace(scope, indexes_.size());
+  }
+}
+
+ScopeMatcher::Scopes ScopeMatcher::compile(
+    const std::vector<std::string>& scopes) const {
+  Scopes compiled;
+  reset(&compiled);
+  for (const std::string& scope : scopes) {
+    add(scope, &compiled);
+  }
+  return compiled;
+}
+
+void ScopeMatcher::reset(Scopes* scopes) const {
+  scopes->words_.assign((indexes_.size() + 63) / 64, 0);
+  scopes->unknown_ = 0;
+}
+
+void ScopeMatcher::add(absl::string_view scope, Scopes* scopes) const {
+  const auto it = indexes_.find(scope);
+  if (it == indexes_.end()) {
+    ++scopes->unknown_;
+    return;
+  }
+  scopes->words_[it->second / 64] |= uint64_t{1} << (it->second % 64);
+}
+
+void ScopeMatcher::parse(absl::string_view scope, Scopes* scopes) const {
+  reset(scopes);
+  for (absl::string_view token :
+       absl::StrSplit(scope, ' ', absl::SkipEmpty())) {
+    add(token, scopes);
+  }
+}
+
+StructUtils::FindResult ScopeMatcher::match(const JwtClaims& claims,
+                                            Scopes* scopes) const {
+  reset(scopes);
+  const JwtClaims::Claim* claim;
+  const StructUtils::FindResult result = claims.GetValue(claim_, claim);
+  if (result != StructUtils::OK) {
+    return result;
+  }
+  if (claim->type == JsonReader::Type::String) {
+    parse(claim->value, scopes);
+    return StructUtils::OK;
+  }
+  if (claim->type != JsonReader::Type::Array) {
+    return StructUtils::WRONG_TYPE;
+  }
+  JsonReader reader(claim->value);
+  reader.beginArray();
+  absl::string_view scope;
+  std::string buffer;
+  while (reader.nextElement()) {
+    if (reader.peek() != JsonReader::Type::String) {
+      reset(scopes);
+      return StructUtils::WRONG_TYPE;
+    }
+    reader.readString(&scope, &buffer);
+    add(scope, scopes);
+  }
+  return StructUtils::OK;
+}
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -178,6 +178,18 @@ std::string getStatusString(Status status) {
 
     case Status::JwksBioAllocError:
       return "Failed to create BIO due to memory allocation failure";
+
+    case Status::JwksFileReadError:
+      return "Failed to read a key file or directory";
+
+    case Status::JwtHeaderBadX5t:
+      return "Jwt header [x5t] or [x5t#S256] field is not a string";
+
+    case Status::JwksProtoParseError:
+      return "Jwks is not a valid serialized JwkSet protobuf message";
+
+    case Status::JwksFileWatchFail:
+      return "Failed to watch a key file for changes";
   };
   // Return empty string though switch-case is exhaustive. See issues/91.
   return "";
@@ -14,117 +14,181 @@
 
 #include "jwt_verify_lib/struct_utils.h"
 
+#include <limits>
+
 #include "absl/strings/str_split.h"
 
 namespace google {
 namespace jwt_verify {
+namespace {
 
-StructUtils::StructUtils(const ::google::protobuf::Struct& struct_pb)
-    : struct_pb_(struct_pb) {}
+// The key to probe a Struct with. The names of a ClaimPath are used as is.
+const std::string& fieldKey(const std::string& name) { return name; }
+std::string fieldKey(absl::string_view name) { return std::string(name); }
 
-StructUtils::FindResult StructUtils::GetString(const std::string& name,
-                                               std::string* str_value) {
-  const ::google::protobuf::Value* found;
-  FindResult result = GetValue(name, found);
-  if (result != OK) {
-    return result;
-  }
-  if (found->kind_case() != google::protobuf::Value::kStringValue) {
-    return WRONG_TYPE;
+// Finds the value at the nested names.
+template <typename Names>
+StructUtils::FindResult findValue(const ::google::protobuf::Struct& struct_pb,
+                                  const Names& names,
+                                  const google::protobuf::Value*& found) {
+  const google::protobuf::Struct* current_struct = &struct_pb;
+  const google::protobuf::Value* value = nullptr;
+  for (const auto& name : names) {
+    if (value != nullptr) {
+      if (value->kind_case() != google::protobuf::Value::kStructValue) {
+        return StructUtils::WRONG_TYPE;
+      }
+      current_struct = &value->struct_value();
+    }
+    const auto& fields = current_struct->fields();
+    const auto it = fields.find(fieldKey(name));
+    if (it == fields.end()) {
+      return StructUtils::MISSING;
+    }
+    value = &it->second;
   }
-  *str_value = found->string_value();
-  return OK;
+  found = value;
+  return StructUtils::OK;
 }
 
-StructUtils::FindResult StructUtils::GetDouble(const std::string& name,
-                                               double* double_value) {
-  const ::google::protobuf::Value* found;
-  FindResult result = GetValue(name, found);
-  if (result != OK) {
-    return result;
+StructUtils::FindResult toString(const google::protobuf::Value& value,
+                                 std::string* str_value) {
+  if (value.kind_case() != google::protobuf::Value::kStringValue) {
+    return StructUtils::WRONG_TYPE;
   }
-  if (found->kind_case() != google::protobuf::Value::kNumberValue) {
-    return WRONG_TYPE;
+  *str_value = value.string_value();
+  return StructUtils::OK;
+}
+
+StructUtils::FindResult toDouble(const google::protobuf::Value& value,
+                                 double* double_value) {
+  if (value.kind_case() != google::protobuf::Value::kNumberValue) {
+    return StructUtils::WRONG_TYPE;
   }
-  *double_value = found->number_value();
-  return OK;
+  *double_value = value.number_value();
+  return StructUtils::OK;
 }
 
-StructUtils::FindResult StructUtils::GetUInt64(const std::string& name,
-                                               uint64_t* int_value) {
+StructUtils::FindResult toUInt64(const google::protobuf::Value& value,
+                                 uint64_t* int_value) {
   double double_value;
-  FindResult result = GetDouble(name, &double_value);
-  if (result != OK) {
+  StructUtils::FindResult result = toDouble(value, &double_value);
+  if (result != StructUtils::OK) {
     return result;
   }
   if (double_value < 0 ||
       double_value >=
           static_cast<double>(std::numeric_limits<uint64_t>::max())) {
-    return OUT_OF_RANGE;
+    return StructUtils::OUT_OF_RANGE;
   }
   *int_value = static_cast<uint64_t>(double_value);
-  return OK;
+  return StructUtils::OK;
 }
 
-StructUtils::FindResult StructUtils::GetBoolean(const std::string& name,
-                                                bool* bool_value) {
-  const ::google::protobuf::Value* found;
-  FindResult result = GetValue(name, found);
-  if (result != OK) {
-    return result;
-  }
-  if (found->kind_case() != google::protobuf::Value::kBoolValue) {
-    return WRONG_TYPE;
+StructUtils::FindResult toBoolean(const google::protobuf::Value& value,
+                                  bool* bool_value) {
+  if (value.kind_case() != google::protobuf::Value::kBoolValue) {
+    return StructUtils::WRONG_TYPE;
   }
-  *bool_value = found->bool_value();
-  return OK;
+  *bool_value = value.bool_value();
+  return StructUtils::OK;
 }
 
-StructUtils::FindResult StructUtils::GetStringList(
-    const std::string& name, std::vector<std::string>* list) {
-  const ::google::protobuf::Value* found;
-  FindResult result = GetValue(name, found);
-  if (result != OK) {
-    return result;
-  }
-  if (found->kind_case() == google::protobuf::Value::kStringValue) {
-    list->push_back(found->string_value());
-    return OK;
+StructUtils::FindResult toStringList(const google::protobuf::Value& value,
+                                     std::vector<std::string>* list) {
+  if (value.kind_case() == google::protobuf::Value::kStringValue) {
+    list->push_back(value.string_value());
+    return StructUtils::OK;
   }
-  if (found->kind_case() == google::protobuf::Value::kListValue) {
-    for (const auto& v : found->list_value().values()) {
+  if (value.kind_case() == google::protobuf::Value::kListValue) {
+    for (const auto& v : value.list_value().values()) {
       if (v.kind_case() != google::protobuf::Value::kStringValue) {
-        return WRONG_TYPE;
+        return StructUtils::WRONG_TYPE;
       }
       list->push_back(v.string_value());
     }
-    return OK;
+    return StructUtils::OK;
   }
-  return WRONG_TYPE;
+  return StructUtils::WRONG_TYPE;
+}
+
+// Finds the value at name or path, and converts it.
+template <typename Name, typename T>
+StructUtils::FindResult getAs(
+    StructUtils* getter, const Name& name,
+    StructUtils::FindResult (*convert)(const google::protobuf::Value&, T*),
+    T* value) {
+  const google::protobuf::Value* found;
+  StructUtils::FindResult result = getter->GetValue(name, found);
+  if (result != StructUtils::OK) {
+    return result;
+  }
+  return convert(*found, value);
+}
+
+}  // namespace
+
+StructUtils::StructUtils(const ::google::protobuf::Struct& struct_pb)
+    : struct_pb_(struct_pb) {}
+
+StructUtils::FindResult StructUtils::GetString(const std::string& name,
+                                               std::string* str_value) {
+  return getAs(this, name, toString, str_value);
+}
+
+StructUtils::FindResult StructUtils::GetString(const ClaimPath& path,
+                                               std::string* str_value) {
+  return getAs(this, path, toString, str_value);
+}
+
+StructUtils::FindResult StructUtils::GetDouble(const std::string& name,
+                                               double* double_value) {
+  return getAs(this, name, toDouble, double_value);
+}
+
+StructUtils::FindResult StructUtils::GetDouble(const ClaimPath& path,
+                                               double* double_value) {
+  return getAs(this, path, toDouble, double_value);
+}
+
+StructUtils::FindResult StructUtils::GetUInt64(const std::string& name,
+                                               uint64_t* int_value) {
+  return getAs(this, name, toUInt64, int_value);
+}
+
+StructUtils::FindResult StructUtils::GetUInt64(const ClaimPath& path,
+                                               uint64_t* int_value) {
+  return getAs(this, path, toUInt64, int_value);
+}
+
+StructUtils::FindResult StructUtils::GetBoolean(const std::string& name,
+                                                bool* bool_value) {
+  return getAs(this, name, toBoolean, bool_value);
+}
+
+StructUtils::FindResult StructUtils::GetBoolean(const ClaimPath& path,
+                                                bool* bool_value) {
+  return getAs(this, path, toBoolean, bool_value);
+}
+
+StructUtils::FindResult StructUtils::GetStringList(
+    const std::string& name, std::vector<std::string>* list) {
+  return getAs(this, name, toStringList, list);
+}
+
+StructUtils::FindResult StructUtils::GetStringList(
+    const ClaimPath& path, std::vector<std::string>* list) {
+  return getAs(this, path, toStringList, list);
 }
 
 StructUtils::FindResult StructUtils::GetValue(
     const std::string& nested_names, const google::protobuf::Value*& found) {
-  const std::vector<absl::string_view> name_vector =
-      absl::StrSplit(nested_names, '.');
+  return findValue(struct_pb_, absl::StrSplit(nested_names, '.'), found);
+}
 
-  const google::protobuf::Struct* current_struct = &struct_pb_;
-  for (int i = 0; i < name_vector.size(); ++i) {
-    const auto& fields = current_struct->fields();
-    const auto it = fields.find(std::string(name_vector[i]));
-    if (it == fields.end()) {
-      return MISSING;
-    }
-    if (i == name_vector.size() - 1) {
-      found = &it->second;
-      return OK;
-    }
-    if (it->second.kind_case() != google::protobuf::Value::kStructValue) {
-      return WRONG_TYPE;
-    }
-    current_struct = &it->second.struct_value();
-  }
-  return MISSING;
+StructUtils::FindResult StructUtils::GetValue(
+    const ClaimPath& path, const google::protobuf::Value*& found) {
+  return findValue(struct_pb_, path.names(), found);
 }
 
 }  // namespace jwt_verify
@@ -0,0 +1,80 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/validated_key_cache.h"
+
+#include "jwt_verify_lib/key_intern_table.h"
+
+namespace google {
+namespace jwt_verify {
+
+ValidatedKeyCache& ValidatedKeyCache::global() {
+  static ValidatedKeyCache* cache = new ValidatedKeyCache(0);
+  return *cache;
+}
+
+ValidatedKeyCache::ValidatedKeyCache(int64_t max_entries)
+    : max_entries_(max_entries), cache_(max_entries, [](Validated*) {}) {}
+
+ValidatedKeyCache::~ValidatedKeyCache() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.clear();
+}
+
+void ValidatedKeyCache::setMaxEntries(int64_t max_entries) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_entries_ = max_entries;
+  cache_.setMaxSize(max_entries);
+}
+
+bool ValidatedKeyCache::enabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_entries_ > 0;
+}
+
+int64_t ValidatedKeyCache::entries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.entries();
+}
+
+std::string ValidatedKeyCache::fingerprint(const BIGNUM* n, const BIGNUM* e) {
+  return KeyInternTable::rsaThumbprint(n, e);
+}
+
+bool ValidatedKeyCache::contains(const std::string& fingerprint) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Validated* found = cache_.lookup(fingerprint);
+  if (found == nullptr) {
+    return false;
+  }
+  cache_.release(fingerprint, found);
+  return true;
+}
+
+void ValidatedKeyCache::insert(const std::string& fingerprint) {
+  static Validated validated;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (max_entries_ <= 0) {
+    return;
+  }
+  Validated* found = cache_.lookup(fingerprint);
+  if (found != nullptr) {
+    cache_.release(fingerprint, found);
+    return;
+  }
+  cache_.insert(fingerprint, &validated, 1);
+}
+
+}  // namespace jwt_verify
+}  // namespace google
@@ -205,6 +205,91 @@ Status verifySignatureEd25519(absl::string_view key,
   return Status::JwtVerificationFail;
 }
 
+// Returns true if a key may verify the Jwt by its kid and alg.
+bool kidAlgMatch(const Jwt& jwt, const Jwks::Pubkey& jwk) {
+  // If kid is specified in JWT, JWK with the same kid is used for
+  // verification.
+  // If kid is not specified in JWT, try all JWK.
+  if (!jwt.kid_.empty() && !jwk.kid_.empty() && jwk.kid_ != jwt.kid_) {
+    return false;
+  }
+
+  // The same alg must be used.
+  return jwk.alg_.empty() || jwk.alg_ == jwt.alg_;
+}
+
+// Verifies the signature of the Jwt with one key. Returns Status::Ok on
+// success, Status::JwtVerificationFail if the key does not verify it, or
+// another error if the Jwt can not be verified by any key.
+Status verifySignatureWithKey(const Jwt& jwt, absl::string_view signed_data,
+                              Jwks::Pubkey* jwk) {
+  // A lazily loaded key is built on its first use. A key that fails to
+  // build can not verify anything, so try the rest of the keys.
+  if (jwk->materialize() != Status::Ok) {
+    return Status::JwtVerificationFail;
+  }
+
+  if (jwk->kty_ == "EC") {
+    const EVP_MD* md;
+    if (jwt.alg_ == "ES384") {
+      md = EVP_sha384();
+    } else if (jwt.alg_ == "ES512") {
+      md = EVP_sha512();
+    } else {
+      // default to SHA256
+      md = EVP_sha256();
+    }
+
+    if (verifySignatureEC(jwk->ec_key(), md, jwt.signature_, signed_data)) {
+      // Verification succeeded.
+      return Status::Ok;
+    }
+  } else if (jwk->kty_ == "RSA") {
+    const EVP_MD* md;
+    if (jwt.alg_ == "RS384" || jwt.alg_ == "PS384") {
+      md = EVP_sha384();
+    } else if (jwt.alg_ == "RS512" || jwt.alg_ == "PS512") {
+      md = EVP_sha512();
+    } else {
+      // default to SHA256
+      md = EVP_sha256();
+    }
+
+    if (jwt.alg_.compare(0, 2, "RS") == 0) {
+      if (verifySignatureRSA(jwk->rsa(), md, jwt.signature_, signed_data)) {
+        // Verification succeeded.
+        return Status::Ok;
+      }
+    } else if (jwt.alg_.compare(0, 2, "PS") == 0) {
+      if (verifySignatureRSAPSS(jwk->rsa(), md, jwt.signature_, signed_data)) {
+        // Verification succeeded.
+        return Status::Ok;
+      }
+    }
+  } else if (jwk->kty_ == "oct") {
+    const EVP_MD* md;
+    if (jwt.alg_ == "HS384") {
+      md = EVP_sha384();
+    } else if (jwt.alg_ == "HS512") {
+      md = EVP_sha512();
+    } else {
+      // default to SHA256
+      md = EVP_sha256();
+    }
+
+    if (verifySignatureOct(jwk->raw_key(), md, jwt.signature_, signed_data)) {
+      // Verification succeeded.
+      return Status::Ok;
+    }
+  } else if (jwk->kty_ == "OKP" && jwk->crv_ == "Ed25519") {
+    // For verification failures keep going and try the rest of the keys in
+    // the JWKS. Otherwise status is either OK or an error with the JWT and we
+    // can return immediately.
+    return verifySignatureEd25519(jwk->raw_key(), jwt.signature_, signed_data);
+  }
+  return Status::JwtVerificationFail;
+}
+
 }  // namespace
 
 Status verifyJwtWithoutTimeChecking(const Jwt& jwt, const Jwks& jwks) {
@@ -212,85 +297,36 @@ Status verifyJwtWithoutTimeChecking(const Jwt& jwt, const Jwks& jwks) {
   std::string signed_data =
       jwt.header_str_base64url_ + '.' + jwt.payload_str_base64url_;
   bool kid_alg_matched = false;
-  for (const auto& jwk : jwks.keys()) {
-    // If kid is specified in JWT, JWK with the same kid is used for
-    // verification.
-    // If kid is not specified in JWT, try all JWK.
-    if (!jwt.kid_.empty() && !jwk->kid_.empty() && jwk->kid_ != jwt.kid_) {
+
+  // A thumbprint in the header selects its key directly. If that key does
+  // not verify the Jwt, the other keys are still tried below.
+  const Jwks::Pubkey* hinted = nullptr;
+  for (const std::string* thumbprint :
+       {&jwt.x5t_s256_, &jwt.x5t_, &jwt.jwk_thumbprint_}) {
+    Jwks::Pubkey* jwk = jwks.findByThumbprint(*thumbprint);
+    if (jwk == nullptr) {
       continue;
     }
+    if (kidAlgMatch(jwt, *jwk)) {
+      kid_alg_matched = true;
+      hinted = jwk;
+      Status status = verifySignatureWithKey(jwt, signed_data, jwk);
+      if (status != Status::JwtVerificationFail) {
+        return status;
+      }
+    }
+    break;
+  }
 
-    // The same alg must be used.
-    if (!jwk->alg_.empty() && jwk->alg_ != jwt.alg_) {
+  for (const auto& jwk : jwks.keys()) {
+    if (jwk.get() == hinted || !kidAlgMatch(jwt, *jwk)) {
       continue;
     }
     kid_alg_matched = true;
 
-    if (jwk->kty_ == "EC") {
-      const EVP_MD* md;
-      if (jwt.alg_ == "ES384") {
-        md = EVP_sha384();
-      } else if (jwt.alg_ == "ES512") {
-        md = EVP_sha512();
-      } else {
-        // default to SHA256
-        md = EVP_sha256();
-      }
-
-      if (verifySignatureEC(jwk->ec_key_.get(), md, jwt.signature_,
-                            signed_data)) {
-        // Verification succeeded.
-        return Status::Ok;
-      }
-    } else if (jwk->kty_ == "RSA") {
-      const EVP_MD* md;
-      if (jwt.alg_ == "RS384" || jwt.alg_ == "PS384") {
-        md = EVP_sha384();
-      } else if (jwt.alg_ == "RS512" || jwt.alg_ == "PS512") {
-        md = EVP_sha512();
-      } else {
-        // default to SHA256
-        md = EVP_sha256();
-      }
-
-      if (jwt.alg_.compare(0, 2, "RS") == 0) {
-        if (verifySignatureRSA(jwk->rsa_.get(), md, jwt.signature_,
-                               signed_data)) {
-          // Verification succeeded.
-          return Status::Ok;
-        }
-      } else if (jwt.alg_.compare(0, 2, "PS") == 0) {
-        if (verifySignatureRSAPSS(jwk->rsa_.get(), md, jwt.signature_,
-                                  signed_data)) {
-          // Verification succeeded.
-          return Status::Ok;
-        }
-      }
-    } else if (jwk->kty_ == "oct") {
-      const EVP_MD* md;
-      if (jwt.alg_ == "HS384") {
-        md = EVP_sha384();
-      } else if (jwt.alg_ == "HS512") {
-        md = EVP_sha512();
-      } else {
-        // default to SHA256
-        md = EVP_sha256();
-      }
-
-      if (verifySignatureOct(jwk->hmac_key_, md, jwt.signature_, signed_data)) {
-        // Verification succeeded.
-        return Status::Ok;
-      }
-    } else if (jwk->kty_ == "OKP" && jwk->crv_ == "Ed25519") {
-      Status status = verifySignatureEd25519(jwk->okp_key_raw_, jwt.signature_,
-                                             signed_data);
-      // For verification failures keep going and try the rest of the keys in
-      // the JWKS. Otherwise status is either OK or an error with the JWT and we
-      // can return immediately.
-      if (status == Status::Ok ||
-          status == Status::JwtEd25519SignatureWrongLength) {
-        return status;
-      }
+    Status status = verifySignatureWithKey(jwt, signed_data, jwk.get());
+    if (status != Status::JwtVerificationFail) {
+      return status;
     }
   }
 
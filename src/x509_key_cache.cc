@@ -0,0 +1,92 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/x509_key_cache.h"
+
+#include "openssl/sha.h"
+
+namespace google {
+namespace jwt_verify {
+
+X509KeyCache& X509KeyCache::global() {
+  static X509KeyCache* cache = new X509KeyCache();
+  return *cache;
+}
+
+X509KeyCache::X509KeyCache() : cache_(0) {}
+
+X509KeyCache::~X509KeyCache() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.clear();
+}
+
+void X509KeyCache::setMaxEntries(int64_t max_entries) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_entries_ = max_entries;
+  cache_.setMaxSize(max_entries);
+}
+
+bool X509KeyCache::enabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_entries_ > 0;
+}
+
+int64_t X509KeyCache::entries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.entries();
+}
+
+std::string X509KeyCache::fingerprint(const std::string& cert_pem) {
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  SHA256(reinterpret_cast<const uint8_t*>(cert_pem.data()), cert_pem.size(),
+         digest);
+  return std::string(reinterpret_cast<const char*>(digest), sizeof(digest));
+}
+
+void X509KeyCache::copy(const Entry& from, Entry* to) {
+  RSA_up_ref(from.rsa.get());
+  to->rsa.reset(from.rsa.get());
+  to->jwk_thumbprint = from.jwk_thumbprint;
+  to->x5t = from.x5t;
+  to->x5t_s256 = from.x5t_s256;
+}
+
+bool X509KeyCache::find(const std::string& fingerprint, Entry* entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Entry* found = cache_.lookup(fingerprint);
+  if (found == nullptr) {
+    return false;
+  }
+  copy(*found, entry);
+  cache_.release(fingerprint, found);
+  return true;
+}
+
+void X509KeyCache::insert(const std::string& fingerprint, const Entry& entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (max_entries_ <= 0 || entry.rsa == nullptr) {
+    return;
+  }
+  Entry* found = cache_.lookup(fingerprint);
+  if (found != nullptr) {
+    cache_.release(fingerprint, found);
+    return;
+  }
+  Entry* cached = new Entry();
+  copy(entry, cached);
+  cache_.insert(fingerprint, cached, 1);
+}
+
+}  // namespace jwt_verify
+}  // namespace google
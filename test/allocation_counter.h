@@ -0,0 +1,45 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global operator new to count heap allocations. Include it in
+// a single source file of a test binary.
+
+namespace google {
+namespace jwt_verify {
+
+std::atomic<size_t> allocation_count{0};
+
+// The number of heap allocations made so far by the test binary.
+size_t allocationCount() { return allocation_count.load(); }
+
+}  // namespace jwt_verify
+}  // namespace google
+
+void* operator new(size_t size) {
+  ++google::jwt_verify::allocation_count;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
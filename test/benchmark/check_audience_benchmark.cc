@@ -0,0 +1,84 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures CheckAudience::areAudiencesAllowed against 1, 10 and 1000
+// configured audiences, for a token whose audience matches and one whose
+// audiences do not.
+//
+// Usage: check_audience_benchmark [checks]
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "jwt_verify_lib/check_audience.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+absl::Duration timeChecks(const CheckAudience& checker,
+                          const std::vector<std::string>& jwt_audiences,
+                          bool expected, int checks) {
+  const absl::Time start = absl::Now();
+  for (int i = 0; i < checks; ++i) {
+    if (checker.areAudiencesAllowed(jwt_audiences) != expected) {
+      std::cerr << "Unexpected audience check result" << std::endl;
+      std::exit(1);
+    }
+  }
+  return (absl::Now() - start) / checks;
+}
+
+void run(int audiences, int checks) {
+  std::vector<std::string> config_audiences;
+  for (int i = 0; i < audiences; ++i) {
+    config_audiences.push_back(
+        absl::StrCat("https://service-", i, ".example.com/"));
+  }
+  const CheckAudience checker(config_audiences);
+
+  // Sanitized like the configured ones, to match the last of them.
+  const std::vector<std::string> matching = {
+      absl::StrCat("http://service-", audiences - 1, ".example.com")};
+  const std::vector<std::string> not_matching = {
+      "https://other-1.example.com/", "https://other-2.example.com/",
+      "other-3.example.com"};
+
+  std::cout << "Check against " << audiences << " audiences, mean of "
+            << checks << " checks:" << std::endl
+            << "  matching:     "
+            << absl::FormatDuration(timeChecks(checker, matching, true, checks))
+            << std::endl
+            << "  not matching: "
+            << absl::FormatDuration(
+                   timeChecks(checker, not_matching, false, checks))
+            << std::endl;
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
+
+int main(int argc, char** argv) {
+  const int checks = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  for (int audiences : {1, 10, 1000}) {
+    google::jwt_verify::run(audiences, checks);
+  }
+  return 0;
+}
@@ -0,0 +1,107 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures a full JWKS refresh, i.e. reloading an unchanged key set of RSA
+// keys, with and without the ValidatedKeyCache.
+//
+// Usage: jwks_refresh_benchmark [keys] [refreshes]
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "jwt_verify_lib/jwks.h"
+#include "jwt_verify_lib/key_intern_table.h"
+#include "jwt_verify_lib/validated_key_cache.h"
+#include "openssl/bn.h"
+#include "openssl/rsa.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+std::string base64UrlBigNum(const BIGNUM* bn) {
+  std::string bytes(BN_num_bytes(bn), '\0');
+  BN_bn2bin(bn, reinterpret_cast<uint8_t*>(&bytes[0]));
+  return absl::WebSafeBase64Escape(bytes);
+}
+
+// Builds a JWKS of freshly generated 2048-bit RSA keys.
+std::string generateJwks(int keys) {
+  bssl::UniquePtr<BIGNUM> e(BN_new());
+  BN_set_word(e.get(), RSA_F4);
+  std::vector<std::string> jwks;
+  for (int i = 0; i < keys; ++i) {
+    bssl::UniquePtr<RSA> rsa(RSA_new());
+    if (!RSA_generate_key_ex(rsa.get(), 2048, e.get(), nullptr)) {
+      std::cerr << "RSA key generation failed" << std::endl;
+      std::exit(1);
+    }
+    jwks.push_back(absl::StrCat(
+        R"({"kty":"RSA","alg":"RS256","kid":"key)", i, R"(","n":")",
+        base64UrlBigNum(RSA_get0_n(rsa.get())), R"(","e":")",
+        base64UrlBigNum(RSA_get0_e(rsa.get())), R"("})"));
+  }
+  return absl::StrCat(R"({"keys":[)", absl::StrJoin(jwks, ","), "]}");
+}
+
+absl::Duration timeRefreshes(const std::string& jwks_text, int refreshes) {
+  const absl::Time start = absl::Now();
+  for (int i = 0; i < refreshes; ++i) {
+    JwksPtr jwks = Jwks::createFrom(jwks_text, Jwks::JWKS);
+    if (jwks->getStatus() != Status::Ok) {
+      std::cerr << "Loading failed: " << getStatusString(jwks->getStatus())
+                << std::endl;
+      std::exit(1);
+    }
+  }
+  return (absl::Now() - start) / refreshes;
+}
+
+void run(int keys, int refreshes) {
+  const std::string jwks_text = generateJwks(keys);
+
+  // With both caches disabled keys are not fingerprinted at all, which is
+  // the baseline of a default build.
+  KeyInternTable::global().setMaxEntries(0);
+  ValidatedKeyCache::global().setMaxEntries(0);
+  const absl::Duration without_cache = timeRefreshes(jwks_text, refreshes);
+
+  ValidatedKeyCache::global().setMaxEntries(10000);
+  const absl::Duration with_cache = timeRefreshes(jwks_text, refreshes);
+
+  std::cout << "Refresh of " << keys << " RSA keys, mean of " << refreshes
+            << " refreshes:" << std::endl
+            << "  without ValidatedKeyCache: "
+            << absl::FormatDuration(without_cache) << std::endl
+            << "  with ValidatedKeyCache:    "
+            << absl::FormatDuration(with_cache) << std::endl;
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
+
+int main(int argc, char** argv) {
+  const int keys = argc > 1 ? std::atoi(argv[1]) : 16;
+  const int refreshes = argc > 2 ? std::atoi(argv[2]) : 1000;
+  google::jwt_verify::run(keys, refreshes);
+  return 0;
+}
@@ -91,6 +91,14 @@ TEST(CheckAudienceTest, TestEmptyAudienceMatch) {
   EXPECT_TRUE(checker.areAudiencesAllowed({""}));
 }
 
+TEST(CheckAudienceTest, TestSanitizedToEmptyAudience) {
+  CheckAudience checker({"https://"});
+  EXPECT_TRUE(checker.areAudiencesAllowed({"http://"}));
+  EXPECT_TRUE(checker.areAudiencesAllowed({"/"}));
+  EXPECT_TRUE(checker.areAudiencesAllowed({"https:///"}));
+  EXPECT_FALSE(checker.areAudiencesAllowed({"//"}));
+}
+
 }  // namespace
 }  // namespace jwt_verify
 }  // namespace google
@@ -0,0 +1,151 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/claim_extractor.h"
+
+#include "gtest/gtest.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+using Type = ClaimExtractor::Type;
+
+const std::string Payload = R"({
+  "iss": "https://example.com",
+  "exp": 1501281058,
+  "neg": -5,
+  "admin": true,
+  "ratio": 0.5,
+  "aud": ["aud1", "aud2"],
+  "realm": {"roles": ["a", "b"], "level": {"value": 3}},
+  "flat": "x"
+})";
+
+TEST(ClaimExtractorTest, ExtractsTypedClaims) {
+  const ClaimExtractor extractor({
+      {"iss", Type::String},
+      {"exp", Type::UInt64},
+      {"neg", Type::Int64},
+      {"admin", Type::Boolean},
+      {"ratio", Type::Double},
+      {"aud", Type::StringList},
+      {"realm.roles", Type::StringList},
+      {"realm.level.value", Type::UInt64},
+      {"realm", Type::Claim},
+  });
+  ASSERT_EQ(extractor.size(), 9);
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  std::vector<ClaimExtractor::Result> results(extractor.size());
+  extractor.extract(claims, results.data());
+
+  for (const auto& result : results) {
+    EXPECT_EQ(result.code, StructUtils::OK);
+    EXPECT_NE(result.claim, nullptr);
+  }
+  EXPECT_EQ(results[0].string_value, "https://example.com");
+  EXPECT_EQ(results[1].uint64_value, 1501281058);
+  EXPECT_EQ(results[2].int64_value, -5);
+  EXPECT_TRUE(results[3].bool_value);
+  EXPECT_EQ(results[4].double_value, 0.5);
+  EXPECT_EQ(results[5].string_list, std::vector<std::string>({"aud1", "aud2"}));
+  EXPECT_EQ(results[6].string_list, std::vector<std::string>({"a", "b"}));
+  EXPECT_EQ(results[7].uint64_value, 3);
+  EXPECT_EQ(results[8].claim->type, JsonReader::Type::Object);
+}
+
+TEST(ClaimExtractorTest, MatchesGetters) {
+  // Every kind of miss, to compare with the JwtClaims getters.
+  const std::vector<ClaimExtractor::Spec> specs = {
+      {"missing", Type::String},
+      {"exp", Type::String},
+      {"iss", Type::UInt64},
+      {"neg", Type::UInt64},
+      {"aud", Type::Boolean},
+      {"flat.x", Type::String},
+      {"flat.x.y", Type::String},
+      {"realm.missing", Type::String},
+      {"realm.level", Type::Double},
+      {"realm.level.value.deeper", Type::UInt64},
+      {"realm.level.value", Type::String},
+      {"realm.level.value", Type::Int64},
+      {"realm.roles", Type::String},
+      {"missing.deeper", Type::Claim},
+      {"", Type::Claim},
+  };
+  const ClaimExtractor extractor(specs);
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  std::vector<ClaimExtractor::Result> results(extractor.size());
+  extractor.extract(claims, results.data());
+
+  for (size_t i = 0; i < specs.size(); ++i) {
+    const ClaimPath& path = specs[i].path;
+    StructUtils::FindResult expected;
+    absl::string_view str_value;
+    uint64_t uint64_value;
+    int64_t int64_value;
+    double double_value;
+    bool bool_value;
+    const JwtClaims::Claim* claim;
+    switch (specs[i].type) {
+      case Type::String:
+        expected = claims.GetString(path, &str_value);
+        break;
+      case Type::UInt64:
+        expected = claims.GetUInt64(path, &uint64_value);
+        break;
+      case Type::Int64:
+        expected = claims.GetInt64(path, &int64_value);
+        break;
+      case Type::Double:
+        expected = claims.GetDouble(path, &double_value);
+        break;
+      case Type::Boolean:
+        expected = claims.GetBoolean(path, &bool_value);
+        break;
+      default:
+        expected = claims.GetValue(path, claim);
+        break;
+    }
+    EXPECT_EQ(results[i].code, expected) << path.path();
+  }
+}
+
+TEST(ClaimExtractorTest, ResultsAreReset) {
+  const ClaimExtractor extractor({
+      {"iss", Type::String},
+      {"aud", Type::StringList},
+  });
+  std::vector<ClaimExtractor::Result> results(extractor.size());
+
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  extractor.extract(claims, results.data());
+  EXPECT_EQ(results[1].string_list.size(), 2);
+
+  ASSERT_TRUE(claims.parse(R"({"sub": "x"})"));
+  extractor.extract(claims, results.data());
+  for (const auto& result : results) {
+    EXPECT_EQ(result.code, StructUtils::MISSING);
+    EXPECT_EQ(result.claim, nullptr);
+  }
+  EXPECT_TRUE(results[0].string_value.empty());
+  EXPECT_TRUE(results[1].string_list.empty());
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
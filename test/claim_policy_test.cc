@@ -0,0 +1,150 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/claim_policy.h"
+
+#include "gtest/gtest.h"
+#include "test/allocation_counter.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+using Op = ClaimPolicy::Op;
+
+const std::string Payload = R"({
+  "iss": "https://idp.example.com/tenants/acme",
+  "tid": "acme",
+  "azp": "client-2",
+  "roles": ["reader", "writer"],
+  "realm": {"roles": "admin"},
+  "exp": 1501281058
+})";
+
+TEST(ClaimPolicyTest, Passes) {
+  const ClaimPolicy policy({
+      {"issuer", "iss", Op::Prefix, {"https://other.com/", "https://idp."}},
+      {"tenant", "tid", Op::Equals, {"acme"}},
+      {"azp", "azp", Op::Equals,
+       {"client-1", "client-2", "client-3", "client-4", "client-5"}},
+      {"roles", "roles", Op::Intersects, {"writer", "admin"}},
+      {"realm", "realm.roles", Op::Intersects, {"admin"}},
+      {"expiry", "exp", Op::Exists, {}},
+  });
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  ClaimPolicy::Lookups lookups;
+  EXPECT_EQ(policy.evaluate(claims, &lookups), nullptr);
+  // Lookups are reused.
+  EXPECT_EQ(policy.evaluate(claims, &lookups), nullptr);
+}
+
+TEST(ClaimPolicyTest, EvaluateDoesNotAllocate) {
+  const ClaimPolicy policy({
+      {"issuer", "iss", Op::Prefix, {"https://idp."}},
+      {"tenant", "tid", Op::Equals, {"acme"}},
+      {"azp", "azp", Op::Equals,
+       {"client-1", "client-2", "client-3", "client-4", "client-5"}},
+      {"roles", "roles", Op::Intersects, {"writer", "admin"}},
+      {"realm", "realm.roles", Op::Intersects, {"admin"}},
+      {"expiry", "exp", Op::Exists, {}},
+  });
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  ClaimPolicy::Lookups lookups;
+  // The first evaluation grows the Lookups and indexes "realm".
+  ASSERT_EQ(policy.evaluate(claims, &lookups), nullptr);
+
+  const size_t allocations = allocationCount();
+  EXPECT_EQ(policy.evaluate(claims, &lookups), nullptr);
+  EXPECT_EQ(allocationCount(), allocations);
+
+  // A token without nested objects allocates nothing on its first
+  // evaluation either.
+  const ClaimPolicy flat_policy({
+      {"tenant", "tid", Op::Equals, {"acme"}},
+      {"roles", "roles", Op::Intersects, {"admin"}},
+  });
+  JwtClaims flat;
+  ASSERT_TRUE(flat.parse(R"({"tid": "acme", "roles": ["a", "admin"]})"));
+  const size_t flat_allocations = allocationCount();
+  EXPECT_EQ(flat_policy.evaluate(flat, &lookups), nullptr);
+  EXPECT_EQ(allocationCount(), flat_allocations);
+}
+
+TEST(ClaimPolicyTest, EachRuleFails) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  ClaimPolicy::Lookups lookups;
+  const std::vector<ClaimPolicy::Rule> rules = {
+      {"missing", "sub", Op::Exists, {}},
+      {"nested missing", "realm.other", Op::Equals, {"admin"}},
+      {"not equal", "tid", Op::Equals, {"other"}},
+      {"not a string", "exp", Op::Equals, {"1501281058"}},
+      {"many not equal", "azp", Op::Equals, {"a", "b", "c", "d", "e", "f"}},
+      {"no prefix", "iss", Op::Prefix, {"https://idp.example.org"}},
+      {"no values", "tid", Op::Prefix, {}},
+      {"no intersection", "roles", Op::Intersects, {"admin"}},
+      {"string list", "tid", Op::Intersects, {"other"}},
+      {"not a list", "exp", Op::Intersects, {"admin"}},
+  };
+  for (const auto& rule : rules) {
+    const ClaimPolicy policy({rule});
+    const ClaimPolicy::Rule* failed = policy.evaluate(claims, &lookups);
+    ASSERT_NE(failed, nullptr) << rule.name;
+    EXPECT_EQ(failed->name, rule.name);
+  }
+
+  ASSERT_TRUE(claims.parse(R"({"roles": ["admin", 1]})"));
+  const ClaimPolicy policy({{"mixed", "roles", Op::Intersects, {"admin"}}});
+  EXPECT_NE(policy.evaluate(claims, &lookups), nullptr);
+}
+
+TEST(ClaimPolicyTest, CheapRulesFirst) {
+  // Both fail; the equality runs before the intersection.
+  const ClaimPolicy policy({
+      {"roles", "roles", Op::Intersects, {"admin"}},
+      {"prefix", "iss", Op::Prefix, {"https://other.com/"}},
+      {"tenant", "tid", Op::Equals, {"other"}},
+      {"tenant again", "tid", Op::Equals, {"another"}},
+  });
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  ClaimPolicy::Lookups lookups;
+  const ClaimPolicy::Rule* failed = policy.evaluate(claims, &lookups);
+  ASSERT_NE(failed, nullptr);
+  EXPECT_EQ(failed->name, "tenant");
+  EXPECT_EQ(failed, &policy.rules()[2]);
+}
+
+TEST(ClaimPolicyTest, EvaluatesJwt) {
+  // {"alg":"RS256","typ":"JWT"}.{"iss":"https://example.com",
+  // "aud":["aud1","aud2"]}.signature
+  Jwt jwt;
+  ASSERT_EQ(jwt.parseFromString(
+                "eyJhbGciOiJSUzI1NiIsInR5cCI6IkpXVCJ9."
+                "eyJpc3MiOiJodHRwczovL2V4YW1wbGUuY29tIiwiYXVkIjpbImF1ZDEiLCJh"
+                "dWQyIl19.c2lnbmF0dXJl"),
+            Status::Ok);
+  const ClaimPolicy policy({
+      {"issuer", "iss", Op::Equals, {"https://example.com"}},
+      {"audience", "aud", Op::Intersects, {"aud2"}},
+  });
+  ClaimPolicy::Lookups lookups;
+  EXPECT_EQ(policy.evaluate(jwt, &lookups), nullptr);
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
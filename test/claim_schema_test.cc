@@ -0,0 +1,105 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/claim_schema.h"
+
+#include "gtest/gtest.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+struct Identity {
+  std::string tenant;
+  absl::string_view email;
+  std::vector<std::string> roles;
+  uint64_t exp = 0;
+  int64_t offset = 0;
+  double score = 0;
+  bool admin = false;
+};
+
+constexpr auto kIdentitySchema = makeClaimSchema(
+    bindClaim("tenant", &Identity::tenant),
+    bindClaim("email", &Identity::email), bindClaim("roles", &Identity::roles),
+    bindClaim("exp", &Identity::exp), bindClaim("offset", &Identity::offset),
+    bindClaim("score", &Identity::score), bindClaim("admin", &Identity::admin));
+
+static_assert(decltype(kIdentitySchema)::kSize == 7, "one code per binding");
+
+TEST(ClaimSchemaTest, BindsMembers) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(R"({
+    "iss": "https://example.com",
+    "tenant": "acme",
+    "email": "user@example.com",
+    "roles": ["reader", "writer"],
+    "exp": 9007199254740993,
+    "offset": -30,
+    "score": 0.75,
+    "admin": true
+  })"));
+  Identity identity;
+  const auto codes = kIdentitySchema.bind(claims, &identity);
+  for (const auto code : codes) {
+    EXPECT_EQ(code, StructUtils::OK);
+  }
+  EXPECT_EQ(identity.tenant, "acme");
+  EXPECT_EQ(identity.email, "user@example.com");
+  EXPECT_EQ(identity.roles, std::vector<std::string>({"reader", "writer"}));
+  EXPECT_EQ(identity.exp, 9007199254740993ULL);
+  EXPECT_EQ(identity.offset, -30);
+  EXPECT_EQ(identity.score, 0.75);
+  EXPECT_TRUE(identity.admin);
+}
+
+TEST(ClaimSchemaTest, ReportsEachClaim) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(R"({
+    "tenant": 1,
+    "roles": "single",
+    "exp": -1,
+    "admin": "yes"
+  })"));
+  Identity identity;
+  identity.email = "unchanged";
+  const auto codes = kIdentitySchema.bind(claims, &identity);
+  EXPECT_EQ(codes[0], StructUtils::WRONG_TYPE);
+  EXPECT_EQ(codes[1], StructUtils::MISSING);
+  EXPECT_EQ(codes[2], StructUtils::OK);
+  EXPECT_EQ(codes[3], StructUtils::OUT_OF_RANGE);
+  EXPECT_EQ(codes[4], StructUtils::MISSING);
+  EXPECT_EQ(codes[5], StructUtils::MISSING);
+  EXPECT_EQ(codes[6], StructUtils::WRONG_TYPE);
+  EXPECT_EQ(identity.email, "unchanged");
+  EXPECT_EQ(identity.roles, std::vector<std::string>({"single"}));
+}
+
+TEST(ClaimSchemaTest, MatchesGetters) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(R"({"tenant": "abc", "exp": 1.5e3})"));
+  Identity identity;
+  const auto codes = kIdentitySchema.bind(claims, &identity);
+
+  std::string tenant;
+  EXPECT_EQ(codes[0], claims.GetString("tenant", &tenant));
+  EXPECT_EQ(identity.tenant, tenant);
+  uint64_t exp;
+  EXPECT_EQ(codes[3], claims.GetUInt64("exp", &exp));
+  EXPECT_EQ(identity.exp, exp);
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
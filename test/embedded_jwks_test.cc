@@ -0,0 +1,207 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/embedded_jwks.h"
+
+#include "gtest/gtest.h"
+#include "jwt_verify_lib/jwks.h"
+#include "jwt_verify_lib/verify.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+const std::string kJwksText = R"(
+{
+  "keys": [
+    {
+      "kty": "RSA",
+      "kid": "rsa",
+      "alg": "RS256",
+      "n": "0vx7agoebGcQSuuPiLJXZptN9nndrQmbXEps2aiAFbWhM78LhWx4cbbfAAtVT86zwu1RK7aPFFxuhDR1L6tSoc_BJECPebWKRXjBZCiFV4n3oknjhMstn64tZ_2W-5JsGY4Hc5n9yBXArwl93lqt7_RN5w6Cf0h4QyQ5v-65YGjQR0_FDW2QvzqY368QQMicAtaSqzs8KJZgnYb9c7d0zgdAZHzu6qMQvRL5hajrn1n91CbOpbISD08qNLyrdkt-bFTWhAI4vMQFh6WeZu0fM4lFd2NcRwr3XPksINHaQ-G_xBniIqbw0Ls1jF44-csFCur-kEgU8awapJzKnqDKgw",
+      "e": "AQAB"
+    },
+    {
+      "kty": "EC",
+      "crv": "P-256",
+      "alg": "ES256",
+      "kid": "abc",
+      "x": "EB54wykhS7YJFD6RYJNnwbWEz3cI7CF5bCDTXlrwI5k",
+      "y": "92bCBTvMFQ8lKbS2MbgjT3YfmYo6HnPEE2tsAqWUJw8"
+    },
+    {
+      "kty": "OKP",
+      "crv": "Ed25519",
+      "alg": "EdDSA",
+      "kid": "okp",
+      "x": "6hH43mEbo-h7iigPm9zLKHH5oEc-bjIXD_t4PLPqHLQ"
+    },
+    {
+      "kty": "oct",
+      "alg": "HS256",
+      "kid": "oct",
+      "k": "LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl"
+    }
+  ]
+}
+)";
+
+// Generated by jwks_embed from kJwksText.
+constexpr uint8_t kKey0First[] = {
+    0xd2, 0xfc, 0x7b, 0x6a, 0x0a, 0x1e, 0x6c, 0x67, 0x10, 0x4a, 0xeb, 0x8f,
+    0x88, 0xb2, 0x57, 0x66, 0x9b, 0x4d, 0xf6, 0x79, 0xdd, 0xad, 0x09, 0x9b,
+    0x5c, 0x4a, 0x6c, 0xd9, 0xa8, 0x80, 0x15, 0xb5, 0xa1, 0x33, 0xbf, 0x0b,
+    0x85, 0x6c, 0x78, 0x71, 0xb6, 0xdf, 0x00, 0x0b, 0x55, 0x4f, 0xce, 0xb3,
+    0xc2, 0xed, 0x51, 0x2b, 0xb6, 0x8f, 0x14, 0x5c, 0x6e, 0x84, 0x34, 0x75,
+    0x2f, 0xab, 0x52, 0xa1, 0xcf, 0xc1, 0x24, 0x40, 0x8f, 0x79, 0xb5, 0x8a,
+    0x45, 0x78, 0xc1, 0x64, 0x28, 0x85, 0x57, 0x89, 0xf7, 0xa2, 0x49, 0xe3,
+    0x84, 0xcb, 0x2d, 0x9f, 0xae, 0x2d, 0x67, 0xfd, 0x96, 0xfb, 0x92, 0x6c,
+    0x19, 0x8e, 0x07, 0x73, 0x99, 0xfd, 0xc8, 0x15, 0xc0, 0xaf, 0x09, 0x7d,
+    0xde, 0x5a, 0xad, 0xef, 0xf4, 0x4d, 0xe7, 0x0e, 0x82, 0x7f, 0x48, 0x78,
+    0x43, 0x24, 0x39, 0xbf, 0xee, 0xb9, 0x60, 0x68, 0xd0, 0x47, 0x4f, 0xc5,
+    0x0d, 0x6d, 0x90, 0xbf, 0x3a, 0x98, 0xdf, 0xaf, 0x10, 0x40, 0xc8, 0x9c,
+    0x02, 0xd6, 0x92, 0xab, 0x3b, 0x3c, 0x28, 0x96, 0x60, 0x9d, 0x86, 0xfd,
+    0x73, 0xb7, 0x74, 0xce, 0x07, 0x40, 0x64, 0x7c, 0xee, 0xea, 0xa3, 0x10,
+    0xbd, 0x12, 0xf9, 0x85, 0xa8, 0xeb, 0x9f, 0x59, 0xfd, 0xd4, 0x26, 0xce,
+    0xa5, 0xb2, 0x12, 0x0f, 0x4f, 0x2a, 0x34, 0xbc, 0xab, 0x76, 0x4b, 0x7e,
+    0x6c, 0x54, 0xd6, 0x84, 0x02, 0x38, 0xbc, 0xc4, 0x05, 0x87, 0xa5, 0x9e,
+    0x66, 0xed, 0x1f, 0x33, 0x89, 0x45, 0x77, 0x63, 0x5c, 0x47, 0x0a, 0xf7,
+    0x5c, 0xf9, 0x2c, 0x20, 0xd1, 0xda, 0x43, 0xe1, 0xbf, 0xc4, 0x19, 0xe2,
+    0x22, 0xa6, 0xf0, 0xd0, 0xbb, 0x35, 0x8c, 0x5e, 0x38, 0xf9, 0xcb, 0x05,
+    0x0a, 0xea, 0xfe, 0x90, 0x48, 0x14, 0xf1, 0xac, 0x1a, 0xa4, 0x9c, 0xca,
+    0x9e, 0xa0, 0xca, 0x83,
+};
+
+constexpr uint8_t kKey0Second[] = {
+    0x01, 0x00, 0x01,
+};
+
+constexpr uint8_t kKey1First[] = {
+    0x10, 0x1e, 0x78, 0xc3, 0x29, 0x21, 0x4b, 0xb6, 0x09, 0x14, 0x3e, 0x91,
+    0x60, 0x93, 0x67, 0xc1, 0xb5, 0x84, 0xcf, 0x77, 0x08, 0xec, 0x21, 0x79,
+    0x6c, 0x20, 0xd3, 0x5e, 0x5a, 0xf0, 0x23, 0x99,
+};
+
+constexpr uint8_t kKey1Second[] = {
+    0xf7, 0x66, 0xc2, 0x05, 0x3b, 0xcc, 0x15, 0x0f, 0x25, 0x29, 0xb4, 0xb6,
+    0x31, 0xb8, 0x23, 0x4f, 0x76, 0x1f, 0x99, 0x8a, 0x3a, 0x1e, 0x73, 0xc4,
+    0x13, 0x6b, 0x6c, 0x02, 0xa5, 0x94, 0x27, 0x0f,
+};
+
+constexpr uint8_t kKey2First[] = {
+    0xea, 0x11, 0xf8, 0xde, 0x61, 0x1b, 0xa3, 0xe8, 0x7b, 0x8a, 0x28, 0x0f,
+    0x9b, 0xdc, 0xcb, 0x28, 0x71, 0xf9, 0xa0, 0x47, 0x3e, 0x6e, 0x32, 0x17,
+    0x0f, 0xfb, 0x78, 0x3c, 0xb3, 0xea, 0x1c, 0xb4,
+};
+
+constexpr uint8_t kKey3First[] = {
+    0x2d, 0xc1, 0xd0, 0x08, 0xb1, 0x13, 0xb5, 0xcf, 0xd0, 0x3b, 0x80, 0xfa,
+    0xf7, 0x34, 0xa6, 0x2f, 0xf4, 0xe0, 0xa9, 0x12, 0x76, 0xcf, 0x77, 0xb0,
+    0x82, 0xc5, 0xcb, 0xe2, 0x85, 0x0a, 0x02, 0x11, 0x84, 0x52, 0x1c, 0x88,
+    0xb7, 0x53, 0x21, 0x91, 0xa5, 0xd1, 0x45, 0xa4, 0x0d, 0x2c, 0xdb, 0xe5,
+};
+
+constexpr EmbeddedJwk kKeys[] = {
+    {"rsa", "RS256", "RSA", "", kKey0First, sizeof(kKey0First), kKey0Second,
+     sizeof(kKey0Second), "NzbLsXh8uDCcd-6MNwXF4W_7noWXFZAfHkxZsRGC9Xs", "",
+     ""},
+    {"abc", "ES256", "EC", "P-256", kKey1First, sizeof(kKey1First), kKey1Second,
+     sizeof(kKey1Second), "Ed7SIVPeIIBz4dK-87AfUGI8n_luTX-VFafAWy8T5BU", "",
+     ""},
+    {"okp", "EdDSA", "OKP", "Ed25519", kKey2First, sizeof(kKey2First), nullptr,
+     0, "c7yG5syiY2u1xQP6wKk0RorHTIxHAxwN7Coq92v5Dm4", "", ""},
+    {"oct", "HS256", "oct", "", kKey3First, sizeof(kKey3First), nullptr, 0, "",
+     "", ""},
+};
+
+constexpr EmbeddedJwks kEmbeddedKeys = {kKeys,
+                                        sizeof(kKeys) / sizeof(kKeys[0])};
+
+// Signed by the "abc" EC key.
+const std::string kJwtES256 =
+    "eyJhbGciOiJFUzI1NiIsInR5cCI6IkpXVCIsImtpZCI6ImFiYyJ9.eyJpc3MiOiI2Mj"
+    "g2NDU3NDE4ODEtbm9hYml1MjNmNWE4bThvdmQ4dWN2Njk4bGo3OHZ2MGxAZGV2ZWxvc"
+    "GVyLmdzZXJ2aWNlYWNjb3VudC5jb20iLCJzdWIiOiI2Mjg2NDU3NDE4ODEtbm9hYml1"
+    "MjNmNWE4bThvdmQ4dWN2Njk4bGo3OHZ2MGxAZGV2ZWxvcGVyLmdzZXJ2aWNlYWNjb3V"
+    "udC5jb20iLCJhdWQiOiJodHRwOi8vbXlzZXJ2aWNlLmNvbS9teWFwaSJ9.T2KAwChqg"
+    "o2ZSXyLh3IcMBQNSeRZRe5Z-MUDl-s-F99XGoyutqA6lq8bKZ6vmjZAlpVG8AGRZW9J"
+    "Gp9lq3cbEw";
+
+// Signed by the "okp" key, without a kid.
+const std::string kJwtEdDSA =
+    "eyJ0eXAiOiJKV1QiLCJhbGciOiJFZERTQSJ9."
+    "eyJpc3MiOiJodHRwczovL2V4YW1wbGUuY29tIiwic3ViIjoidGVzdEBleGFtcGxlLmNvbSJ9."
+    "rn-h5xTejtilHiAG6aKJEQ3e5_"
+    "aIKC7nwKUPOjBqN8df69JLiFtKxFCDINHtCNhoeLkgcDHHo2SJFincVH_OCg";
+
+TEST(EmbeddedJwksTest, MatchesJwks) {
+  auto embedded = Jwks::createFromEmbedded(kEmbeddedKeys);
+  auto jwks = Jwks::createFrom(kJwksText, Jwks::JWKS);
+  ASSERT_EQ(embedded->getStatus(), Status::Ok);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+  ASSERT_EQ(embedded->keys().size(), jwks->keys().size());
+
+  for (size_t i = 0; i < jwks->keys().size(); ++i) {
+    const Jwks::Pubkey& expected = *jwks->keys()[i];
+    const Jwks::Pubkey& key = *embedded->keys()[i];
+    EXPECT_EQ(key.kid_, expected.kid_);
+    EXPECT_EQ(key.alg_, expected.alg_);
+    EXPECT_EQ(key.kty_, expected.kty_);
+    EXPECT_EQ(key.crv_, expected.crv_);
+    EXPECT_EQ(key.material(), expected.material());
+    EXPECT_EQ(key.raw_key(), expected.raw_key());
+    EXPECT_EQ(key.thumbprint_, expected.thumbprint_);
+  }
+  EXPECT_EQ(embedded->findByThumbprint(
+                "NzbLsXh8uDCcd-6MNwXF4W_7noWXFZAfHkxZsRGC9Xs"),
+            embedded->keys()[0].get());
+}
+
+TEST(EmbeddedJwksTest, VerifiesJwt) {
+  auto embedded = Jwks::createFromEmbedded(kEmbeddedKeys);
+  ASSERT_EQ(embedded->getStatus(), Status::Ok);
+
+  for (const std::string& jwt_text : {kJwtES256, kJwtEdDSA}) {
+    Jwt jwt;
+    ASSERT_EQ(jwt.parseFromString(jwt_text), Status::Ok);
+    EXPECT_EQ(verifyJwt(jwt, *embedded), Status::Ok);
+  }
+}
+
+TEST(EmbeddedJwksTest, SkipsBadKeys) {
+  static constexpr uint8_t kZeros[32] = {};
+  static constexpr EmbeddedJwk kBadKeys[] = {
+      {"ec", "", "EC", "P-256", kZeros, sizeof(kZeros), kZeros,
+       sizeof(kZeros), "", "", ""},
+      {"okp", "", "OKP", "Ed25519", kZeros, 16, nullptr, 0, "", "", ""},
+      {"dsa", "", "DSA", "", kZeros, sizeof(kZeros), nullptr, 0, "", "", ""},
+  };
+  auto embedded = Jwks::createFromEmbedded({kBadKeys, 3});
+  EXPECT_EQ(embedded->getStatus(), Status::JwksEcParseError);
+  EXPECT_TRUE(embedded->keys().empty());
+
+  // Valid keys are kept.
+  const EmbeddedJwk mixed[] = {kBadKeys[1], kKeys[1]};
+  embedded = Jwks::createFromEmbedded({mixed, 2});
+  EXPECT_EQ(embedded->getStatus(), Status::Ok);
+  ASSERT_EQ(embedded->keys().size(), 1);
+  EXPECT_EQ(embedded->keys()[0]->kid_, "abc");
+
+  embedded = Jwks::createFromEmbedded({nullptr, 0});
+  EXPECT_EQ(embedded->getStatus(), Status::JwksNoKeys);
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
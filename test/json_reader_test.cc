@@ -0,0 +1,261 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/json_reader.h"
+
+#include "google/protobuf/struct.pb.h"
+#include "google/protobuf/util/json_util.h"
+#include "gtest/gtest.h"
+#include "test/allocation_counter.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+// Reads a whole document as a top level object.
+bool readDocument(absl::string_view json) {
+  JsonReader reader(json);
+  absl::string_view name;
+  if (reader.beginObject()) {
+    while (reader.nextMember(&name)) {
+      if (!reader.skipValue()) {
+        break;
+      }
+    }
+  }
+  return reader.done();
+}
+
+bool protobufAccepts(absl::string_view json) {
+  ::google::protobuf::Struct struct_pb;
+  ::google::protobuf::util::JsonParseOptions options;
+  return ::google::protobuf::util::JsonStringToMessage(
+             std::string(json), &struct_pb, options)
+      .ok();
+}
+
+TEST(JsonReaderTest, ReadsValues) {
+  JsonReader reader(R"({
+    "null": null, "bool": true, "number": -1.5e3,
+    "string": "abc", "escaped": "a\"é😀",
+    "object": {"a": [1, {"b": false}]}
+  })");
+  absl::string_view name;
+  ASSERT_TRUE(reader.beginObject());
+
+  ASSERT_TRUE(reader.nextMember(&name));
+  EXPECT_EQ(name, "null");
+  EXPECT_EQ(reader.peek(), JsonReader::Type::Null);
+  EXPECT_TRUE(reader.readNull());
+
+  ASSERT_TRUE(reader.nextMember(&name));
+  EXPECT_EQ(name, "bool");
+  bool bool_value = false;
+  EXPECT_TRUE(reader.readBool(&bool_value));
+  EXPECT_TRUE(bool_value);
+
+  ASSERT_TRUE(reader.nextMember(&name));
+  EXPECT_EQ(name, "number");
+  absl::string_view number_text;
+  EXPECT_TRUE(reader.readNumber(&number_text));
+  EXPECT_EQ(number_text, "-1.5e3");
+
+  ASSERT_TRUE(reader.nextMember(&name));
+  EXPECT_EQ(name, "string");
+  absl::string_view view;
+  std::string buffer;
+  EXPECT_TRUE(reader.readString(&view, &buffer));
+  EXPECT_EQ(view, "abc");
+  // Without escapes, the string is a view of the input.
+  EXPECT_TRUE(buffer.empty());
+
+  ASSERT_TRUE(reader.nextMember(&name));
+  EXPECT_EQ(name, "escaped");
+  std::string value;
+  EXPECT_TRUE(reader.readString(&value));
+  EXPECT_EQ(value, "a\"\xC3\xA9\xF0\x9F\x98\x80");
+
+  ASSERT_TRUE(reader.nextMember(&name));
+  EXPECT_EQ(name, "object");
+  EXPECT_EQ(reader.peek(), JsonReader::Type::Object);
+  EXPECT_TRUE(reader.skipValue());
+
+  EXPECT_FALSE(reader.nextMember(&name));
+  EXPECT_TRUE(reader.done());
+}
+
+TEST(JsonReaderTest, ReadsArrays) {
+  JsonReader reader(R"({"a": [1, 2.5, 1e-400]})");
+  absl::string_view name;
+  ASSERT_TRUE(reader.beginObject());
+  ASSERT_TRUE(reader.nextMember(&name));
+  ASSERT_TRUE(reader.beginArray());
+  std::vector<double> values;
+  while (reader.nextElement()) {
+    double value;
+    ASSERT_TRUE(reader.readNumber(&value));
+    values.push_back(value);
+  }
+  EXPECT_EQ(values, std::vector<double>({1, 2.5, 0}));
+  EXPECT_FALSE(reader.nextMember(&name));
+  EXPECT_TRUE(reader.done());
+}
+
+TEST(JsonReaderTest, ReadingArraysDoesNotAllocate) {
+  const std::string json = R"(["a", "b", 1.5, true, null, ["c"]])";
+  absl::string_view value;
+  std::string buffer;
+  const size_t allocations = allocationCount();
+  JsonReader reader(json);
+  ASSERT_TRUE(reader.beginArray());
+  ASSERT_TRUE(reader.nextElement());
+  EXPECT_TRUE(reader.readString(&value, &buffer));
+  EXPECT_EQ(value, "a");
+  while (reader.nextElement()) {
+    EXPECT_TRUE(reader.skipValue());
+  }
+  EXPECT_TRUE(reader.done());
+  EXPECT_EQ(allocationCount(), allocations);
+}
+
+TEST(JsonReaderTest, FailureIsSticky) {
+  JsonReader reader(R"({"a": nul, "b": 1})");
+  absl::string_view name;
+  ASSERT_TRUE(reader.beginObject());
+  ASSERT_TRUE(reader.nextMember(&name));
+  EXPECT_FALSE(reader.skipValue());
+  EXPECT_TRUE(reader.failed());
+  EXPECT_FALSE(reader.nextMember(&name));
+  EXPECT_EQ(reader.peek(), JsonReader::Type::Invalid);
+  EXPECT_FALSE(reader.done());
+}
+
+TEST(JsonReaderTest, WrongTypeFails) {
+  JsonReader reader(R"({"a": 1})");
+  absl::string_view name;
+  ASSERT_TRUE(reader.beginObject());
+  ASSERT_TRUE(reader.nextMember(&name));
+  std::string value;
+  EXPECT_FALSE(reader.readString(&value));
+  EXPECT_TRUE(reader.failed());
+}
+
+TEST(JsonReaderTest, EscapedNamesOutliveTheirObject) {
+  JsonReader reader(R"({"k\u0069d": {"a\u0062": 1}})");
+  absl::string_view outer;
+  absl::string_view inner;
+  ASSERT_TRUE(reader.beginObject());
+  ASSERT_TRUE(reader.nextMember(&outer));
+  ASSERT_TRUE(reader.beginObject());
+  ASSERT_TRUE(reader.nextMember(&inner));
+  ASSERT_TRUE(reader.skipValue());
+  EXPECT_FALSE(reader.nextMember(&inner));
+  EXPECT_FALSE(reader.nextMember(&outer));
+  EXPECT_TRUE(reader.done());
+  EXPECT_EQ(outer, "kid");
+  EXPECT_EQ(inner, "ab");
+}
+
+TEST(JsonReaderTest, DepthIsLimited) {
+  const std::string ok_nesting =
+      "{\"a\":" + std::string(98, '[') + std::string(98, ']') + "}";
+  EXPECT_TRUE(readDocument(ok_nesting));
+  const std::string deep_nesting =
+      "{\"a\":" + std::string(100, '[') + std::string(100, ']') + "}";
+  EXPECT_FALSE(readDocument(deep_nesting));
+}
+
+// Documents on which the reader agrees with protobuf's JSON parser, which
+// it replaces in the key set parser.
+struct CompatCase {
+  const char* json;
+  bool accepted;
+};
+
+const CompatCase kCompatCases[] = {
+    {R"({})", true},
+    {" \t\r\n\f\v{}\n", true},
+    {R"({"a": 1, "b": [true, false, null, "s", {}]})", true},
+    // Trailing commas are accepted, but not empty entries.
+    {R"({"a": 1,})", true},
+    {R"({"a": [1,]})", true},
+    {R"({,})", false},
+    {R"({"a": 1,,})", false},
+    {R"({"a": [,]})", false},
+    {R"({"a": [1,,]})", false},
+    // Single quotes and unquoted names.
+    {R"({'a': 'b'})", true},
+    {R"({a: 1, _b: 2, $c: 3, d4: 4})", true},
+    {R"({true_name: 1, nullable: 2})", true},
+    {R"({true: 1})", false},
+    {R"({null: 1})", false},
+    {R"({4d: 1})", false},
+    // Duplicate names, at any level.
+    {R"({"a": 1, "a": 2})", false},
+    {R"({"a": 1, a: 2})", false},
+    {R"({"a": {"b": 1, "b": 2}})", false},
+    {R"({"a": [{"b": 1, "b": 2}]})", false},
+    {R"({"a": {"b": 1}, "c": {"b": 2}})", true},
+    {R"({"ab": 1, "ab": 2})", false},
+    // Numbers.
+    {R"({"a": [0, -0, 1.5, -2e10, 1E+2, 1e-400]})", true},
+    {R"({"a": [1., -.5, 0., 1.e5]})", true},
+    {R"({"a": 01})", false},
+    {R"({"a": -01})", false},
+    {R"({"a": 00})", false},
+    {R"({"a": 1e999})", false},
+    {R"({"a": -1e999})", false},
+    {R"({"a": 1e})", false},
+    {R"({"a": -})", false},
+    {R"({"a": .})", false},
+    {R"({"a": 1.2.3})", false},
+    // Strings.
+    {R"({"a": "\x"})", true},
+    {R"({"a": "\/\b\f\n\r\t\\"})", true},
+    {"{\"a\": \"\x01\"}", true},
+    {R"({"a": "😀"})", true},
+    {R"({"a": "\ud83d"})", false},
+    {R"({"a": "\ude00"})", false},
+    {R"({"a": "\u12"})", false},
+    {R"({"a": "abc})", false},
+    {"{\"a\": \"\xC3\xA9\"}", true},
+    {"{\"a\": \"\xC0\xAF\"}", false},
+    {"{\"a\": \"\xED\xA0\x80\"}", false},
+    {"{\"a\": \"\xF4\x90\x80\x80\"}", false},
+    {"{\"a\": \"\xC3\"}", false},
+    // Literals.
+    {R"({"a": nul})", false},
+    {R"({"a": True})", false},
+    // Documents that are not one object.
+    {"", false},
+    {"  ", false},
+    {R"([])", false},
+    {R"("a")", false},
+    {R"({"a": 1} x)", false},
+    {R"({"a": 1}})", false},
+    {R"({"a": 1)", false},
+    {R"({"a" 1})", false},
+    {R"({"a": 1 "b": 2})", false},
+};
+
+TEST(JsonReaderTest, MatchesProtobufParser) {
+  for (const auto& test : kCompatCases) {
+    EXPECT_EQ(readDocument(test.json), test.accepted) << test.json;
+    EXPECT_EQ(protobufAccepts(test.json), test.accepted) << test.json;
+  }
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
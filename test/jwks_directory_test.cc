@@ -0,0 +1,171 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/jwks_directory.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "jwt_verify_lib/jwks.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+const std::string PemRsa = R"(
+-----BEGIN PUBLIC KEY-----
+MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEAzgP9Xw2xvul2pZNjCpJD
+/L16FmKH/zt53seeo2/eBKzcUs3nDO33aYdjsCAAFaQfXSAe0PfmwbytmH9RMHOJ
+PUU2ApcEt63K5+3v5n+kqKfmym2lOebqpLgsdXIXvTsHYYy/10GGM+NPgyMUgU8q
+JSaPOOA/ZJ1eWQTyfgJCPeIarzcTaf+eSD3CQaDDpi488RFc3O86pho5x3KTHSg4
+CxHp0ua1RV2pNGJP1BqN0oX09Rgpjo7GE+ukpCMO7zOCwSeBjnqL/zdJ7pjo//u0
+dhGpdbcejNZhl1NN+0q1eogwJPM295/7xRSW77mmcUI8W4oLDHLz1zxRoX9yK9xv
+3wIDAQAB
+-----END PUBLIC KEY-----
+)";
+
+const std::string PemEc = R"(
+-----BEGIN PUBLIC KEY-----
+MFkwEwYHKoZIzj0CAQYIKoZIzj0DAQcDQgAEQ4x/MTt08crvf9NsENzTH+XT3QdI
+HCLizGaWwk3uaY7jx93jqFGY5z1xlXe3zyPgEZATV3IjloAkT6uxN6A2YA==
+-----END PUBLIC KEY-----
+)";
+
+const std::string JwksOct = R"(
+{
+  "keys": [
+    {
+      "kty": "oct",
+      "alg": "HS256",
+      "kid": "oct1",
+      "k": "LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl"
+    },
+    {
+      "kty": "oct",
+      "alg": "HS256",
+      "kid": "oct2",
+      "k": "7KoqXCyDO8ee-FJl1kQyK3eAFN8lgVu5Hzpt_FwV5Fzdv2fjHG_yaAkwmGuTJJw5"
+    }
+  ]
+}
+)";
+
+class JwksDirectoryTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    const char* tmp = getenv("TEST_TMPDIR");
+    std::string dir_template =
+        std::string(tmp != nullptr ? tmp : "/tmp") + "/jwks_XXXXXX";
+    ASSERT_NE(mkdtemp(&dir_template[0]), nullptr);
+    dir_ = dir_template;
+  }
+
+  void TearDown() override {
+    for (const std::string& name : files_) {
+      unlink((dir_ + "/" + name).c_str());
+    }
+    rmdir(dir_.c_str());
+  }
+
+  void writeFile(const std::string& name, const std::string& contents) {
+    std::ofstream(dir_ + "/" + name) << contents;
+    files_.push_back(name);
+  }
+
+  std::string dir_;
+  std::vector<std::string> files_;
+};
+
+TEST_F(JwksDirectoryTest, LoadsAllKeyFiles) {
+  writeFile("rsa.pem", PemRsa);
+  writeFile("ec.pem", PemEc);
+  writeFile("oct.jwks", JwksOct);
+  writeFile("README", "not a key");
+
+  std::vector<Jwks::FileStatus> file_statuses;
+  auto jwks = loadJwksDirectory(dir_, Jwks::LoadOptions(), &file_statuses);
+  EXPECT_EQ(jwks->getStatus(), Status::Ok);
+
+  // Keys are merged in the order of the file names.
+  ASSERT_EQ(jwks->keys().size(), 4);
+  EXPECT_EQ(jwks->keys()[0]->kid_, "ec");
+  EXPECT_EQ(jwks->keys()[0]->kty_, "EC");
+  EXPECT_EQ(jwks->keys()[1]->kid_, "oct1");
+  EXPECT_EQ(jwks->keys()[2]->kid_, "oct2");
+  EXPECT_EQ(jwks->keys()[3]->kid_, "rsa");
+  EXPECT_EQ(jwks->keys()[3]->kty_, "RSA");
+  EXPECT_TRUE(jwks->keys()[3]->alg_.empty());
+
+  ASSERT_EQ(file_statuses.size(), 3);
+  EXPECT_EQ(file_statuses[0].path, dir_ + "/ec.pem");
+  for (const auto& file_status : file_statuses) {
+    EXPECT_EQ(file_status.status, Status::Ok);
+  }
+}
+
+TEST_F(JwksDirectoryTest, ReportsPerFileStatus) {
+  writeFile("a.pem", "bad pem");
+  writeFile("b.json", "bad json");
+  writeFile("c.jwks", JwksOct);
+  writeFile("d.pem", "");
+
+  std::vector<Jwks::FileStatus> file_statuses;
+  auto jwks = loadJwksDirectory(dir_, Jwks::LoadOptions(), &file_statuses);
+  EXPECT_EQ(jwks->getStatus(), Status::Ok);
+  EXPECT_EQ(jwks->keys().size(), 2);
+
+  ASSERT_EQ(file_statuses.size(), 4);
+  EXPECT_EQ(file_statuses[0].status, Status::JwksPemBadBase64);
+  EXPECT_EQ(file_statuses[1].status, Status::JwksParseError);
+  EXPECT_EQ(file_statuses[2].status, Status::Ok);
+  EXPECT_EQ(file_statuses[3].status, Status::JwksPemBadBase64);
+}
+
+TEST_F(JwksDirectoryTest, NoValidKeys) {
+  auto jwks = loadJwksDirectory(dir_, Jwks::LoadOptions());
+  EXPECT_EQ(jwks->getStatus(), Status::JwksNoKeys);
+
+  writeFile("a.pem", "bad pem");
+  jwks = loadJwksDirectory(dir_, Jwks::LoadOptions());
+  EXPECT_EQ(jwks->getStatus(), Status::JwksPemBadBase64);
+  EXPECT_TRUE(jwks->keys().empty());
+
+  jwks = loadJwksDirectory(dir_ + "/missing", Jwks::LoadOptions());
+  EXPECT_EQ(jwks->getStatus(), Status::JwksFileReadError);
+}
+
+TEST_F(JwksDirectoryTest, SameResultOnAnyThreadCount) {
+  for (int i = 0; i < 40; ++i) {
+    writeFile("key" + std::to_string(100 + i) + ".pem",
+              i % 2 == 0 ? PemRsa : PemEc);
+  }
+  Jwks::LoadOptions options;
+  options.threads = 1;
+  auto serial = loadJwksDirectory(dir_, options);
+  options.threads = 8;
+  auto parallel = loadJwksDirectory(dir_, options);
+  ASSERT_EQ(serial->keys().size(), 40);
+  ASSERT_EQ(parallel->keys().size(), 40);
+  for (size_t i = 0; i < serial->keys().size(); ++i) {
+    EXPECT_EQ(serial->keys()[i]->kid_, parallel->keys()[i]->kid_);
+    EXPECT_EQ(serial->keys()[i]->kty_, parallel->keys()[i]->kty_);
+  }
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,228 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/jwks_file_watcher.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include "absl/time/clock.h"
+#include "gtest/gtest.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+// Two key sets of two keys each, whose kids start with "a" and "b".
+const std::string JwksA = R"(
+{
+  "keys": [
+    {
+      "kty": "oct",
+      "alg": "HS256",
+      "kid": "a1",
+      "k": "LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl"
+    },
+    {
+      "kty": "oct",
+      "alg": "HS256",
+      "kid": "a2",
+      "k": "7KoqXCyDO8ee-FJl1kQyK3eAFN8lgVu5Hzpt_FwV5Fzdv2fjHG_yaAkwmGuTJJw5"
+    }
+  ]
+}
+)";
+
+const std::string JwksB = R"(
+{
+  "keys": [
+    {
+      "kty": "oct",
+      "alg": "HS256",
+      "kid": "b1",
+      "k": "7KoqXCyDO8ee-FJl1kQyK3eAFN8lgVu5Hzpt_FwV5Fzdv2fjHG_yaAkwmGuTJJw5"
+    },
+    {
+      "kty": "oct",
+      "alg": "HS256",
+      "kid": "b2",
+      "k": "LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl"
+    }
+  ]
+}
+)";
+
+class JwksFileWatcherTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    const char* tmp = getenv("TEST_TMPDIR");
+    std::string dir_template =
+        std::string(tmp != nullptr ? tmp : "/tmp") + "/jwks_watch_XXXXXX";
+    ASSERT_NE(mkdtemp(&dir_template[0]), nullptr);
+    dir_ = dir_template;
+    path_ = dir_ + "/jwks.json";
+    options_.debounce = absl::Milliseconds(1);
+    writeFile(path_, JwksA);
+  }
+
+  void TearDown() override {
+    unlink(path_.c_str());
+    unlink((path_ + ".tmp").c_str());
+    rmdir(dir_.c_str());
+  }
+
+  // Rewrites a file in place, in chunks of chunk_size bytes, so that the
+  // watcher may see it half written.
+  static void writeFile(const std::string& path, const std::string& contents,
+                        size_t chunk_size = std::string::npos) {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    ASSERT_GE(fd, 0);
+    for (size_t i = 0; i < contents.size(); i += chunk_size) {
+      const size_t len = std::min(chunk_size, contents.size() - i);
+      ASSERT_EQ(write(fd, contents.data() + i, len), len);
+    }
+    close(fd);
+  }
+
+  // Waits up to 10 seconds for done to be true.
+  static bool waitFor(const std::function<bool()>& done) {
+    const absl::Time deadline = absl::Now() + absl::Seconds(10);
+    while (!done()) {
+      if (absl::Now() > deadline) {
+        return false;
+      }
+      absl::SleepFor(absl::Milliseconds(1));
+    }
+    return true;
+  }
+
+  static std::string firstKid(const JwksFileWatcher& watcher) {
+    std::shared_ptr<const Jwks> jwks = watcher.jwks();
+    return jwks == nullptr ? "" : jwks->keys()[0]->kid_;
+  }
+
+  std::string dir_;
+  std::string path_;
+  JwksFileWatcher::Options options_;
+};
+
+TEST_F(JwksFileWatcherTest, ReloadsOnWrite) {
+  JwksFileWatcher watcher(path_, options_);
+  EXPECT_EQ(watcher.jwks(), nullptr);
+  ASSERT_EQ(watcher.start(), Status::Ok);
+  EXPECT_EQ(firstKid(watcher), "a1");
+  EXPECT_EQ(watcher.generation(), 1);
+
+  writeFile(path_, JwksB);
+  EXPECT_TRUE(waitFor([&] { return firstKid(watcher) == "b1"; }));
+  EXPECT_EQ(watcher.lastLoadStatus(), Status::Ok);
+}
+
+TEST_F(JwksFileWatcherTest, ReloadsOnRename) {
+  JwksFileWatcher watcher(path_, options_);
+  ASSERT_EQ(watcher.start(), Status::Ok);
+
+  writeFile(path_ + ".tmp", JwksB);
+  ASSERT_EQ(rename((path_ + ".tmp").c_str(), path_.c_str()), 0);
+  EXPECT_TRUE(waitFor([&] { return firstKid(watcher) == "b1"; }));
+}
+
+TEST_F(JwksFileWatcherTest, BadFileKeepsLastGood) {
+  JwksFileWatcher watcher(path_, options_);
+  ASSERT_EQ(watcher.start(), Status::Ok);
+  std::shared_ptr<const Jwks> good = watcher.jwks();
+
+  writeFile(path_, "{");
+  EXPECT_TRUE(waitFor(
+      [&] { return watcher.lastLoadStatus() == Status::JwksParseError; }));
+  EXPECT_EQ(watcher.jwks(), good);
+  EXPECT_EQ(watcher.generation(), 1);
+
+  writeFile(path_, JwksB);
+  EXPECT_TRUE(waitFor([&] { return firstKid(watcher) == "b1"; }));
+}
+
+TEST_F(JwksFileWatcherTest, StartsWithoutFile) {
+  unlink(path_.c_str());
+  JwksFileWatcher watcher(path_, options_);
+  EXPECT_EQ(watcher.start(), Status::JwksFileReadError);
+  EXPECT_EQ(watcher.jwks(), nullptr);
+
+  writeFile(path_, JwksA);
+  EXPECT_TRUE(waitFor([&] { return firstKid(watcher) == "a1"; }));
+}
+
+TEST_F(JwksFileWatcherTest, MissingDirectory) {
+  JwksFileWatcher watcher(dir_ + "/missing/jwks.json", options_);
+  EXPECT_EQ(watcher.start(), Status::JwksFileWatchFail);
+}
+
+TEST_F(JwksFileWatcherTest, DebouncesBursts) {
+  options_.debounce = absl::Milliseconds(500);
+  JwksFileWatcher watcher(path_, options_);
+  ASSERT_EQ(watcher.start(), Status::Ok);
+
+  for (int i = 0; i < 10; ++i) {
+    writeFile(path_, i % 2 == 0 ? JwksB : JwksA);
+  }
+  writeFile(path_, JwksB);
+  EXPECT_TRUE(waitFor([&] { return firstKid(watcher) == "b1"; }));
+  EXPECT_EQ(watcher.generation(), 2);
+}
+
+TEST_F(JwksFileWatcherTest, ReadersNeverSeeTornKeySet) {
+  JwksFileWatcher watcher(path_, options_);
+  ASSERT_EQ(watcher.start(), Status::Ok);
+
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+  std::atomic<int> reads{0};
+  std::thread reader([&] {
+    while (!done) {
+      std::shared_ptr<const Jwks> jwks = watcher.jwks();
+      ++reads;
+      // Every published key set is one of the two files, whole.
+      if (jwks->keys().size() != 2 ||
+          jwks->keys()[0]->kid_[0] != jwks->keys()[1]->kid_[0]) {
+        ++torn;
+      }
+    }
+  });
+
+  // Rewrite the file in place in small chunks, so that many reloads read it
+  // half written.
+  for (int i = 0; i < 50; ++i) {
+    writeFile(path_, i % 2 == 0 ? JwksB : JwksA, /*chunk_size=*/16);
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+  writeFile(path_, JwksB, /*chunk_size=*/16);
+  EXPECT_TRUE(waitFor([&] { return firstKid(watcher) == "b1"; }));
+  done = true;
+  reader.join();
+
+  EXPECT_EQ(torn, 0);
+  EXPECT_GT(reads, 0);
+  EXPECT_GT(watcher.generation(), 1);
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,236 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/escaping.h"
+#include "gtest/gtest.h"
+#include "jwt_verify_lib/jwks.h"
+#include "jwt_verify_lib/verify.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+const std::string kJwksText = R"(
+{
+  "keys": [
+    {
+      "kty": "RSA",
+      "kid": "rsa",
+      "alg": "RS256",
+      "n": "0vx7agoebGcQSuuPiLJXZptN9nndrQmbXEps2aiAFbWhM78LhWx4cbbfAAtVT86zwu1RK7aPFFxuhDR1L6tSoc_BJECPebWKRXjBZCiFV4n3oknjhMstn64tZ_2W-5JsGY4Hc5n9yBXArwl93lqt7_RN5w6Cf0h4QyQ5v-65YGjQR0_FDW2QvzqY368QQMicAtaSqzs8KJZgnYb9c7d0zgdAZHzu6qMQvRL5hajrn1n91CbOpbISD08qNLyrdkt-bFTWhAI4vMQFh6WeZu0fM4lFd2NcRwr3XPksINHaQ-G_xBniIqbw0Ls1jF44-csFCur-kEgU8awapJzKnqDKgw",
+      "e": "AQAB"
+    },
+    {
+      "kty": "EC",
+      "crv": "P-256",
+      "alg": "ES256",
+      "kid": "abc",
+      "x": "EB54wykhS7YJFD6RYJNnwbWEz3cI7CF5bCDTXlrwI5k",
+      "y": "92bCBTvMFQ8lKbS2MbgjT3YfmYo6HnPEE2tsAqWUJw8"
+    },
+    {
+      "kty": "OKP",
+      "crv": "Ed25519",
+      "alg": "EdDSA",
+      "kid": "okp",
+      "x": "6hH43mEbo-h7iigPm9zLKHH5oEc-bjIXD_t4PLPqHLQ"
+    },
+    {
+      "kty": "oct",
+      "alg": "HS256",
+      "kid": "oct",
+      "k": "LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl"
+    }
+  ]
+}
+)";
+
+// Signed by the "abc" EC key.
+const std::string kJwtES256 =
+    "eyJhbGciOiJFUzI1NiIsInR5cCI6IkpXVCIsImtpZCI6ImFiYyJ9.eyJpc3MiOiI2Mj"
+    "g2NDU3NDE4ODEtbm9hYml1MjNmNWE4bThvdmQ4dWN2Njk4bGo3OHZ2MGxAZGV2ZWxvc"
+    "GVyLmdzZXJ2aWNlYWNjb3VudC5jb20iLCJzdWIiOiI2Mjg2NDU3NDE4ODEtbm9hYml1"
+    "MjNmNWE4bThvdmQ4dWN2Njk4bGo3OHZ2MGxAZGV2ZWxvcGVyLmdzZXJ2aWNlYWNjb3V"
+    "udC5jb20iLCJhdWQiOiJodHRwOi8vbXlzZXJ2aWNlLmNvbS9teWFwaSJ9.T2KAwChqg"
+    "o2ZSXyLh3IcMBQNSeRZRe5Z-MUDl-s-F99XGoyutqA6lq8bKZ6vmjZAlpVG8AGRZW9J"
+    "Gp9lq3cbEw";
+
+std::string decode(absl::string_view base64url) {
+  std::string bytes;
+  EXPECT_TRUE(absl::WebSafeBase64Unescape(base64url, &bytes));
+  return bytes;
+}
+
+// The keys of kJwksText.
+JwkSet makeJwkSet() {
+  JwkSet jwk_set;
+  JwkSet::Key* key = jwk_set.add_keys();
+  key->set_kty("RSA");
+  key->set_kid("rsa");
+  key->set_alg("RS256");
+  key->set_n(decode(
+      "0vx7agoebGcQSuuPiLJXZptN9nndrQmbXEps2aiAFbWhM78LhWx4cbbfAAtVT86zwu1RK7aP"
+      "FFxuhDR1L6tSoc_BJECPebWKRXjBZCiFV4n3oknjhMstn64tZ_2W-5JsGY4Hc5n9yBXArwl9"
+      "3lqt7_RN5w6Cf0h4QyQ5v-65YGjQR0_FDW2QvzqY368QQMicAtaSqzs8KJZgnYb9c7d0zgdA"
+      "ZHzu6qMQvRL5hajrn1n91CbOpbISD08qNLyrdkt-bFTWhAI4vMQFh6WeZu0fM4lFd2NcRwr3"
+      "XPksINHaQ-G_xBniIqbw0Ls1jF44-csFCur-kEgU8awapJzKnqDKgw"));
+  key->set_e(decode("AQAB"));
+
+  key = jwk_set.add_keys();
+  key->set_kty("EC");
+  key->set_crv("P-256");
+  key->set_alg("ES256");
+  key->set_kid("abc");
+  key->set_x(decode("EB54wykhS7YJFD6RYJNnwbWEz3cI7CF5bCDTXlrwI5k"));
+  key->set_y(decode("92bCBTvMFQ8lKbS2MbgjT3YfmYo6HnPEE2tsAqWUJw8"));
+
+  key = jwk_set.add_keys();
+  key->set_kty("OKP");
+  key->set_crv("Ed25519");
+  key->set_alg("EdDSA");
+  key->set_kid("okp");
+  key->set_x(decode("6hH43mEbo-h7iigPm9zLKHH5oEc-bjIXD_t4PLPqHLQ"));
+
+  key = jwk_set.add_keys();
+  key->set_kty("oct");
+  key->set_alg("HS256");
+  key->set_kid("oct");
+  key->set_k(
+      decode("LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl"));
+  return jwk_set;
+}
+
+void expectSameKeys(const Jwks& keys, const Jwks& expected_keys) {
+  ASSERT_EQ(keys.keys().size(), expected_keys.keys().size());
+  for (size_t i = 0; i < expected_keys.keys().size(); ++i) {
+    const Jwks::Pubkey& expected = *expected_keys.keys()[i];
+    const Jwks::Pubkey& key = *keys.keys()[i];
+    EXPECT_EQ(key.kid_, expected.kid_);
+    EXPECT_EQ(key.alg_, expected.alg_);
+    EXPECT_EQ(key.kty_, expected.kty_);
+    EXPECT_EQ(key.crv_, expected.crv_);
+    EXPECT_EQ(key.material(), expected.material());
+    EXPECT_EQ(key.raw_key(), expected.raw_key());
+    EXPECT_EQ(key.thumbprint_, expected.thumbprint_);
+  }
+}
+
+TEST(JwksProtoTest, MatchesJwks) {
+  auto jwks = Jwks::createFrom(kJwksText, Jwks::JWKS);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+
+  auto keys = Jwks::createFromProto(makeJwkSet());
+  ASSERT_EQ(keys->getStatus(), Status::Ok);
+  expectSameKeys(*keys, *jwks);
+  EXPECT_EQ(
+      keys->findByThumbprint("NzbLsXh8uDCcd-6MNwXF4W_7noWXFZAfHkxZsRGC9Xs"),
+      keys->keys()[0].get());
+
+  // The same from a serialized message.
+  auto serialized =
+      Jwks::createFrom(makeJwkSet().SerializeAsString(), Jwks::PROTO);
+  ASSERT_EQ(serialized->getStatus(), Status::Ok);
+  expectSameKeys(*serialized, *jwks);
+
+  Jwt jwt;
+  ASSERT_EQ(jwt.parseFromString(kJwtES256), Status::Ok);
+  EXPECT_EQ(verifyJwt(jwt, *keys), Status::Ok);
+}
+
+TEST(JwksProtoTest, LeadingZerosKeepThumbprint) {
+  JwkSet jwk_set = makeJwkSet();
+  JwkSet::Key* rsa = jwk_set.mutable_keys(0);
+  rsa->set_n(std::string(1, '\0') + rsa->n());
+  rsa->set_e(std::string(2, '\0') + rsa->e());
+
+  auto keys = Jwks::createFromProto(jwk_set);
+  ASSERT_EQ(keys->getStatus(), Status::Ok);
+  EXPECT_EQ(keys->keys()[0]->thumbprint_,
+            "NzbLsXh8uDCcd-6MNwXF4W_7noWXFZAfHkxZsRGC9Xs");
+}
+
+TEST(JwksProtoTest, BadKeys) {
+  struct BadKey {
+    // Applied to a copy of one of the keys of makeJwkSet().
+    int index;
+    void (*mutate)(JwkSet::Key* key);
+    Status status;
+  };
+  const BadKey bad_keys[] = {
+      {0, [](JwkSet::Key* key) { key->clear_kty(); }, Status::JwksMissingKty},
+      {0, [](JwkSet::Key* key) { key->set_kty("DSA"); },
+       Status::JwksNotImplementedKty},
+      {0, [](JwkSet::Key* key) { key->set_alg("ES256"); },
+       Status::JwksRSAKeyBadAlg},
+      {0, [](JwkSet::Key* key) { key->clear_n(); }, Status::JwksRSAKeyMissingN},
+      {0, [](JwkSet::Key* key) { key->clear_e(); }, Status::JwksRSAKeyMissingE},
+      {0, [](JwkSet::Key* key) { key->set_e(std::string(1, '\x05')); },
+       Status::JwksRsaParseError},
+      {1, [](JwkSet::Key* key) { key->set_alg("RS256"); },
+       Status::JwksECKeyBadAlg},
+      {1, [](JwkSet::Key* key) { key->set_crv("P-384"); },
+       Status::JwksECKeyAlgNotCompatibleWithCrv},
+      {1,
+       [](JwkSet::Key* key) {
+         key->clear_alg();
+         key->set_crv("P-192");
+       },
+       Status::JwksECKeyAlgOrCrvUnsupported},
+      {1, [](JwkSet::Key* key) { key->clear_x(); }, Status::JwksECKeyMissingX},
+      {1, [](JwkSet::Key* key) { key->clear_y(); }, Status::JwksECKeyMissingY},
+      {1, [](JwkSet::Key* key) { key->set_y(key->x()); },
+       Status::JwksEcParseError},
+      {2, [](JwkSet::Key* key) { key->set_alg("ES256"); },
+       Status::JwksOKPKeyBadAlg},
+      {2, [](JwkSet::Key* key) { key->clear_crv(); },
+       Status::JwksOKPKeyMissingCrv},
+      {2, [](JwkSet::Key* key) { key->set_crv("X25519"); },
+       Status::JwksOKPKeyCrvUnsupported},
+      {2, [](JwkSet::Key* key) { key->clear_x(); }, Status::JwksOKPKeyMissingX},
+      {2, [](JwkSet::Key* key) { key->set_x("short"); },
+       Status::JwksOKPXWrongLength},
+      {3, [](JwkSet::Key* key) { key->set_alg("RS256"); },
+       Status::JwksHMACKeyBadAlg},
+      {3, [](JwkSet::Key* key) { key->clear_k(); },
+       Status::JwksHMACKeyMissingK},
+  };
+
+  const JwkSet good = makeJwkSet();
+  for (const BadKey& bad_key : bad_keys) {
+    JwkSet jwk_set;
+    *jwk_set.add_keys() = good.keys(bad_key.index);
+    bad_key.mutate(jwk_set.mutable_keys(0));
+    auto keys = Jwks::createFromProto(jwk_set);
+    EXPECT_EQ(keys->getStatus(), bad_key.status)
+        << getStatusString(bad_key.status);
+
+    // Like keys in a JWKS, bad keys are skipped.
+    *jwk_set.add_keys() = good.keys(3);
+    keys = Jwks::createFromProto(jwk_set);
+    EXPECT_EQ(keys->getStatus(), Status::Ok);
+    ASSERT_EQ(keys->keys().size(), 1);
+    EXPECT_EQ(keys->keys()[0]->kid_, "oct");
+  }
+}
+
+TEST(JwksProtoTest, BadKeySet) {
+  EXPECT_EQ(Jwks::createFromProto(JwkSet())->getStatus(), Status::JwksNoKeys);
+  EXPECT_EQ(Jwks::createFrom("", Jwks::PROTO)->getStatus(), Status::JwksNoKeys);
+  EXPECT_EQ(Jwks::createFrom("not a message", Jwks::PROTO)->getStatus(),
+            Status::JwksProtoParseError);
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
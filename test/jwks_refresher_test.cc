@@ -0,0 +1,191 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/jwks_refresher.h"
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+const std::string PublicKeyOct1 = R"(
+{
+  "keys": [
+    {
+      "kty": "oct",
+      "alg": "HS256",
+      "kid": "kid1",
+      "k": "LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl"
+    }
+  ]
+}
+)";
+
+const std::string PublicKeyOct2 = R"(
+{
+  "keys": [
+    {
+      "kty": "oct",
+      "alg": "HS256",
+      "kid": "kid2",
+      "k": "7KoqXCyDO8ee-FJl1kQyK3eAFN8lgVu5Hzpt_FwV5Fzdv2fjHG_yaAkwmGuTJJw5"
+    }
+  ]
+}
+)";
+
+// A local in-process fetch stub driven by the test.
+class JwksRefresherTest : public testing::Test {
+ protected:
+  JwksRefresherTest() {
+    options_.refresh_interval = absl::Minutes(10);
+    options_.jitter = 0;
+    options_.initial_backoff = absl::Seconds(1);
+    options_.max_backoff = absl::Seconds(4);
+    options_.min_unknown_kid_interval = absl::Seconds(30);
+    options_.clock = [this] { return now_; };
+  }
+
+  JwksRefresher::Fetcher fetcher() {
+    return [this](std::string* jwks_text) {
+      ++fetch_count_;
+      *jwks_text = response_;
+      return fetch_status_;
+    };
+  }
+
+  JwksRefresher::Options options_;
+  absl::Time now_ = absl::FromUnixSeconds(1000);
+  std::string response_ = PublicKeyOct1;
+  Status fetch_status_ = Status::Ok;
+  std::atomic<int> fetch_count_{0};
+};
+
+TEST_F(JwksRefresherTest, RefreshesOnInterval) {
+  JwksRefresher refresher(fetcher(), options_);
+  EXPECT_EQ(refresher.jwks(), nullptr);
+
+  EXPECT_TRUE(refresher.refreshIfDue());
+  ASSERT_NE(refresher.jwks(), nullptr);
+  EXPECT_EQ(refresher.jwks()->keys()[0]->kid_, "kid1");
+  EXPECT_EQ(refresher.nextRefreshTime(), now_ + absl::Minutes(10));
+
+  now_ += absl::Minutes(5);
+  EXPECT_FALSE(refresher.refreshIfDue());
+  EXPECT_EQ(fetch_count_, 1);
+
+  response_ = PublicKeyOct2;
+  now_ += absl::Minutes(5);
+  EXPECT_TRUE(refresher.refreshIfDue());
+  EXPECT_EQ(refresher.jwks()->keys()[0]->kid_, "kid2");
+}
+
+TEST_F(JwksRefresherTest, ServesLastGoodAndBacksOff) {
+  JwksRefresher refresher(fetcher(), options_);
+  EXPECT_TRUE(refresher.refreshIfDue());
+  std::shared_ptr<const Jwks> good = refresher.jwks();
+
+  now_ += absl::Minutes(10);
+  fetch_status_ = Status::JwksFetchFail;
+  EXPECT_TRUE(refresher.refreshIfDue());
+  EXPECT_EQ(refresher.lastRefreshStatus(), Status::JwksFetchFail);
+  EXPECT_EQ(refresher.jwks(), good);
+  EXPECT_EQ(refresher.nextRefreshTime(), now_ + absl::Seconds(1));
+
+  // The backoff doubles up to max_backoff.
+  for (absl::Duration backoff :
+       {absl::Seconds(2), absl::Seconds(4), absl::Seconds(4)}) {
+    now_ = refresher.nextRefreshTime();
+    EXPECT_TRUE(refresher.refreshIfDue());
+    EXPECT_EQ(refresher.nextRefreshTime(), now_ + backoff);
+  }
+
+  // A key set that does not parse is a failure as well.
+  fetch_status_ = Status::Ok;
+  response_ = "{}";
+  now_ = refresher.nextRefreshTime();
+  EXPECT_TRUE(refresher.refreshIfDue());
+  EXPECT_EQ(refresher.lastRefreshStatus(), Status::JwksNoKeys);
+  EXPECT_EQ(refresher.jwks(), good);
+
+  // Success resets the backoff.
+  response_ = PublicKeyOct2;
+  now_ = refresher.nextRefreshTime();
+  EXPECT_TRUE(refresher.refreshIfDue());
+  EXPECT_EQ(refresher.lastRefreshStatus(), Status::Ok);
+  EXPECT_EQ(refresher.jwks()->keys()[0]->kid_, "kid2");
+  EXPECT_EQ(refresher.nextRefreshTime(), now_ + absl::Minutes(10));
+}
+
+TEST_F(JwksRefresherTest, JitteredInterval) {
+  options_.jitter = 0.2;
+  JwksRefresher refresher(fetcher(), options_);
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_TRUE(refresher.refreshIfDue());
+    EXPECT_GE(refresher.nextRefreshTime(), now_ + absl::Minutes(8));
+    EXPECT_LE(refresher.nextRefreshTime(), now_ + absl::Minutes(12));
+    now_ = refresher.nextRefreshTime();
+  }
+}
+
+TEST_F(JwksRefresherTest, UnknownKidTriggersRateLimitedRefresh) {
+  JwksRefresher refresher(fetcher(), options_);
+  EXPECT_TRUE(refresher.refreshIfDue());
+
+  Jwt jwt;
+  jwt.kid_ = "kid2";
+  // Other failures and known kids do not trigger a refresh.
+  EXPECT_FALSE(refresher.onVerifyStatus(jwt, Status::JwtVerificationFail));
+  Jwt known_kid;
+  known_kid.kid_ = "kid1";
+  EXPECT_FALSE(refresher.onVerifyStatus(known_kid, Status::JwksKidAlgMismatch));
+  EXPECT_FALSE(refresher.refreshIfDue());
+
+  response_ = PublicKeyOct2;
+  EXPECT_TRUE(refresher.onVerifyStatus(jwt, Status::JwksKidAlgMismatch));
+  EXPECT_TRUE(refresher.refreshIfDue());
+  EXPECT_EQ(refresher.jwks()->keys()[0]->kid_, "kid2");
+
+  // Another unknown kid within min_unknown_kid_interval is rate limited.
+  jwt.kid_ = "kid3";
+  now_ += absl::Seconds(10);
+  EXPECT_FALSE(refresher.onVerifyStatus(jwt, Status::JwksKidAlgMismatch));
+  EXPECT_FALSE(refresher.refreshIfDue());
+
+  now_ += absl::Seconds(30);
+  EXPECT_TRUE(refresher.onVerifyStatus(jwt, Status::JwksKidAlgMismatch));
+  EXPECT_TRUE(refresher.refreshIfDue());
+  EXPECT_EQ(fetch_count_, 3);
+}
+
+TEST_F(JwksRefresherTest, BackgroundThread) {
+  options_.refresh_interval = absl::Milliseconds(1);
+  options_.clock = absl::Now;
+  JwksRefresher refresher(fetcher(), options_);
+  refresher.start();
+  while (fetch_count_ < 3) {
+    std::this_thread::yield();
+  }
+  refresher.stop();
+  ASSERT_NE(refresher.jwks(), nullptr);
+  EXPECT_EQ(refresher.jwks()->keys()[0]->kid_, "kid1");
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,176 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/jwks_registry.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+const std::string PublicKeyOct = R"(
+{
+  "keys": [
+    {
+      "kty": "oct",
+      "alg": "HS256",
+      "kid": "62a93512c9ee4c7f8067b5a216dade2763d32a47",
+      "k": "LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl7KoqXCyDO8ee-FJl1kQyK3eAFN8lgVu5Hzpt_FwV5Fzdv2fjHG_yaAkwmGuTJJw5YgkYLhZI-4hQTdI16k9RHF0AxM6TXkGnTUw8WW2xQHn6yScU9cSt-AN_6Ujkd3ZxsXKrZHBxHgtg0r6VjB-g2FeUAK6ZeT-ukb9hlRXpl0sR3VUwb6xAOkeXHYx-ufkYkUNCsh9zI7l_UWo0x4MofNKK3_mv6-vkHYG_9iz_Pn9Hb_oMBhlh6yspT6DDKpxOzb1TwDwgJ5x1ibYxhTcUcw"
+    }
+  ]
+}
+)";
+
+class JwksRegistryTest : public testing::Test {
+ protected:
+  JwksRegistry::Loader countingLoader() {
+    return [this](const std::string& issuer) -> JwksPtr {
+      ++load_count_;
+      if (issuer == "unknown") {
+        return nullptr;
+      }
+      if (issuer == "bad") {
+        return Jwks::createFrom("bad json", Jwks::JWKS);
+      }
+      return Jwks::createFrom(PublicKeyOct, Jwks::JWKS);
+    };
+  }
+
+  std::atomic<int> load_count_{0};
+};
+
+TEST_F(JwksRegistryTest, LoadsOnMissOnly) {
+  JwksRegistry registry(countingLoader(), 1 << 20);
+  {
+    JwksRegistry::Handle handle = registry.lookup("issuer1");
+    ASSERT_EQ(handle.status(), Status::Ok);
+    ASSERT_TRUE(handle);
+    EXPECT_EQ(handle->keys().size(), 1);
+  }
+  JwksRegistry::Handle handle = registry.lookup("issuer1");
+  EXPECT_EQ(handle.status(), Status::Ok);
+  EXPECT_EQ(load_count_, 1);
+  EXPECT_EQ(registry.entries(), 1);
+  EXPECT_GT(registry.size(), 0);
+}
+
+TEST_F(JwksRegistryTest, LookupByJwtIssuer) {
+  JwksRegistry registry(countingLoader(), 1 << 20);
+  Jwt jwt;
+  jwt.iss_ = "https://example.com";
+  JwksRegistry::Handle handle = registry.lookup(jwt);
+  EXPECT_EQ(handle.status(), Status::Ok);
+  EXPECT_EQ(handle->keys()[0]->kid_,
+            "62a93512c9ee4c7f8067b5a216dade2763d32a47");
+}
+
+TEST_F(JwksRegistryTest, FailedLoadsAreNotCached) {
+  JwksRegistry registry(countingLoader(), 1 << 20);
+  JwksRegistry::Handle handle = registry.lookup("unknown");
+  EXPECT_EQ(handle.status(), Status::JwksFetchFail);
+  EXPECT_FALSE(handle);
+
+  handle = registry.lookup("bad");
+  EXPECT_EQ(handle.status(), Status::JwksParseError);
+  EXPECT_FALSE(handle);
+
+  handle = registry.lookup("unknown");
+  EXPECT_EQ(load_count_, 3);
+  EXPECT_EQ(registry.entries(), 0);
+}
+
+TEST_F(JwksRegistryTest, EvictsUnpinnedKeySets) {
+  int64_t one_set;
+  {
+    JwksRegistry sizing(countingLoader(), 1 << 20);
+    sizing.lookup("issuer");
+    one_set = sizing.size();
+  }
+
+  JwksRegistry registry(countingLoader(), one_set + one_set / 2);
+  registry.lookup("issuer1");
+  registry.lookup("issuer2");
+  EXPECT_EQ(registry.entries(), 1);
+  EXPECT_LE(registry.size(), one_set + one_set / 2);
+
+  // issuer1 was evicted and is loaded again.
+  load_count_ = 0;
+  registry.lookup("issuer1");
+  EXPECT_EQ(load_count_, 1);
+}
+
+TEST_F(JwksRegistryTest, PinnedKeySetsAreNotEvicted) {
+  JwksRegistry registry(countingLoader(), 1);
+  JwksRegistry::Handle handle1 = registry.lookup("issuer1");
+  JwksRegistry::Handle handle2 = registry.lookup("issuer2");
+  EXPECT_EQ(registry.entries(), 2);
+  EXPECT_EQ(handle1->keys().size(), 1);
+  EXPECT_EQ(handle2->keys().size(), 1);
+
+  // Removed key sets stay alive while pinned.
+  registry.remove("issuer1");
+  EXPECT_EQ(registry.entries(), 1);
+  EXPECT_EQ(handle1->keys().size(), 1);
+}
+
+TEST_F(JwksRegistryTest, ConcurrentMissesShareOneLoad) {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool release_loader = false;
+  JwksRegistry registry(
+      [&](const std::string&) -> JwksPtr {
+        ++load_count_;
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return release_loader; });
+        return Jwks::createFrom(PublicKeyOct, Jwks::JWKS);
+      },
+      1 << 20);
+
+  std::vector<const Jwks*> found(8, nullptr);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < found.size(); ++i) {
+    threads.emplace_back([&registry, &found, i] {
+      JwksRegistry::Handle handle = registry.lookup("issuer");
+      found[i] = handle.get();
+    });
+  }
+  while (load_count_ == 0) {
+    std::this_thread::yield();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    release_loader = true;
+  }
+  cv.notify_all();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(load_count_, 1);
+  for (const Jwks* jwks : found) {
+    EXPECT_NE(jwks, nullptr);
+    EXPECT_EQ(jwks, found[0]);
+  }
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
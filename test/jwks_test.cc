@@ -14,6 +14,11 @@
 
 #include "jwt_verify_lib/jwks.h"
 
+#include <thread>
+
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
 #include "gtest/gtest.h"
 #include "test/test_common.h"
 
@@ -160,6 +165,63 @@ TEST(JwksParseTest, JwksWrongKeys) {
   EXPECT_EQ(jwks->getStatus(), Status::JwksBadKeys);
 }
 
+TEST(JwksParseTest, JwksDuplicateMember) {
+  const std::string jwks_text = R"(
+   {
+      "keys": [
+        {
+           "kty": "oct",
+           "alg": "HS256",
+           "kid": "62a93512c9ee4c7f8067b5a216dade2763d32a47",
+           "kid": "other",
+           "k": "LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl"
+        }
+      ]
+   }
+)";
+  auto jwks = Jwks::createFrom(jwks_text, Jwks::JWKS);
+  EXPECT_EQ(jwks->getStatus(), Status::JwksParseError);
+  EXPECT_EQ(jwks->keys().size(), 0);
+}
+
+TEST(JwksParseTest, JwksSyntaxErrorAfterKeys) {
+  // The keys read before the error are dropped.
+  const std::string jwks_text = R"(
+   {
+      "keys": [
+        {
+           "kty": "oct",
+           "alg": "HS256",
+           "kid": "62a93512c9ee4c7f8067b5a216dade2763d32a47",
+           "k": "LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl"
+        }
+      ],
+      "extra": [1 2]
+   }
+)";
+  auto jwks = Jwks::createFrom(jwks_text, Jwks::JWKS);
+  EXPECT_EQ(jwks->getStatus(), Status::JwksParseError);
+  EXPECT_EQ(jwks->keys().size(), 0);
+}
+
+TEST(JwksParseTest, JwksTrailingCommas) {
+  const std::string jwks_text = R"(
+   {
+      "keys": [
+        {
+           "kty": "oct",
+           "alg": "HS256",
+           "kid": "62a93512c9ee4c7f8067b5a216dade2763d32a47",
+           "k": "LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl",
+        },
+      ],
+   }
+)";
+  auto jwks = Jwks::createFrom(jwks_text, Jwks::JWKS);
+  EXPECT_EQ(jwks->getStatus(), Status::Ok);
+  EXPECT_EQ(jwks->keys().size(), 1);
+}
+
 TEST(JwksParseTest, JwksInvalidKty) {
   // Invalid kty field
   const std::string jwks_text = R"(
@@ -1071,6 +1133,20 @@ TEST(JwksParseTest, JwksGoodX509) {
   EXPECT_TRUE(kids.find(jwks->keys()[1]->kid_) != kids.end());
 }
 
+TEST(JwksParseTest, JwksX509RetainCert) {
+  auto jwks = Jwks::createFrom(kPublicKeyX509, Jwks::JWKS);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+  EXPECT_EQ(jwks->keys()[0]->x509_, nullptr);
+  EXPECT_NE(jwks->keys()[0]->rsa(), nullptr);
+
+  Jwks::LoadOptions options;
+  options.retain_x509 = true;
+  auto retained = Jwks::createFrom(kPublicKeyX509, Jwks::JWKS, options);
+  ASSERT_EQ(retained->getStatus(), Status::Ok);
+  EXPECT_NE(retained->keys()[0]->x509_, nullptr);
+  EXPECT_GT(retained->memoryUsage(), jwks->memoryUsage());
+}
+
 TEST(JwksParseTest, RealJwksX509) {
   auto jwks = Jwks::createFrom(kRealX509Jwks, Jwks::JWKS);
   EXPECT_EQ(jwks->getStatus(), Status::Ok);
@@ -1345,6 +1421,422 @@ bad-pub-key
   EXPECT_EQ(jwks->keys().size(), 1);
 }
 
+TEST(JwksParseTest, LazyRsaAndEcKeys) {
+  const std::string jwks_text = R"(
+      {
+        "keys": [
+          {
+            "kty": "RSA",
+            "alg": "RS256",
+            "kid": "rsa",
+            "n": "0YWnm_eplO9BFtXszMRQNL5UtZ8HJdTH2jK7vjs4XdLkPW7YBkkm_2xNgcaVpkW0VT2l4mU3KftR-6s3Oa5Rnz5BrWEUkCTVVolR7VYksfqIB2I_x5yZHdOiomMTcm3DheUUCgbJRv5OKRnNqszA4xHn3tA3Ry8VO3X7BgKZYAUh9fyZTFLlkeAh0-bLK5zvqCmKW5QgDIXSxUTJxPjZCgfx1vmAfGqaJb-nvmrORXQ6L284c73DUL7mnt6wj3H6tVqPKA27j56N0TB1Hfx4ja6Slr8S4EB3F1luYhATa1PKUSH8mYDW11HolzZmTQpRoLV8ZoHbHEaTfqX_aYahIw",
+            "e": "AQAB"
+          },
+          {
+            "kty": "EC",
+            "crv": "P-256",
+            "x": "EB54wykhS7YJFD6RYJNnwbWEz3cI7CF5bCDTXlrwI5k",
+            "y": "92bCBTvMFQ8lKbS2MbgjT3YfmYo6HnPEE2tsAqWUJw8",
+            "alg": "ES256",
+            "kid": "ec"
+          }
+        ]
+      }
+)";
+  Jwks::LoadOptions options;
+  options.lazy = true;
+  auto jwks = Jwks::createFrom(jwks_text, Jwks::JWKS, options);
+  EXPECT_EQ(jwks->getStatus(), Status::Ok);
+  ASSERT_EQ(jwks->keys().size(), 2);
+
+  // Nothing is built at load time.
+  EXPECT_EQ(jwks->keys()[0]->kid_, "rsa");
+  EXPECT_EQ(jwks->keys()[0]->rsa(), nullptr);
+  EXPECT_NE(jwks->keys()[0]->lazy(), nullptr);
+  EXPECT_EQ(jwks->keys()[1]->kid_, "ec");
+  EXPECT_EQ(jwks->keys()[1]->crv_, "P-256");
+  EXPECT_EQ(jwks->keys()[1]->ec_key(), nullptr);
+  EXPECT_NE(jwks->keys()[1]->lazy(), nullptr);
+
+  EXPECT_EQ(jwks->keys()[0]->materialize(), Status::Ok);
+  EXPECT_NE(jwks->keys()[0]->rsa(), nullptr);
+  EXPECT_EQ(jwks->keys()[0]->lazy(), nullptr);
+  EXPECT_EQ(jwks->keys()[1]->materialize(), Status::Ok);
+  EXPECT_NE(jwks->keys()[1]->ec_key(), nullptr);
+  EXPECT_EQ(jwks->keys()[1]->lazy(), nullptr);
+
+  // Materializing again is a no-op.
+  EXPECT_EQ(jwks->keys()[0]->materialize(), Status::Ok);
+}
+
+TEST(JwksParseTest, LazyBadBase64FailsAtLoad) {
+  const std::string jwks_text = R"(
+      {
+        "keys": [
+          {
+            "kty": "RSA",
+            "n": "not base64!",
+            "e": "AQAB"
+          }
+        ]
+      }
+)";
+  Jwks::LoadOptions options;
+  options.lazy = true;
+  auto jwks = Jwks::createFrom(jwks_text, Jwks::JWKS, options);
+  EXPECT_EQ(jwks->getStatus(), Status::JwksRsaParseError);
+  EXPECT_EQ(jwks->keys().size(), 0);
+}
+
+TEST(JwksParseTest, LazyBadKeyFailsOnFirstUse) {
+  // "e" is 5, which is only rejected when the key is built.
+  const std::string jwks_text = R"(
+      {
+        "keys": [
+          {
+            "kty": "RSA",
+            "n": "0YWnm_eplO9BFtXszMRQNL5UtZ8HJdTH2jK7vjs4XdLkPW7YBkkm_2xNgcaVpkW0VT2l4mU3KftR-6s3Oa5Rnz5BrWEUkCTVVolR7VYksfqIB2I_x5yZHdOiomMTcm3DheUUCgbJRv5OKRnNqszA4xHn3tA3Ry8VO3X7BgKZYAUh9fyZTFLlkeAh0-bLK5zvqCmKW5QgDIXSxUTJxPjZCgfx1vmAfGqaJb-nvmrORXQ6L284c73DUL7mnt6wj3H6tVqPKA27j56N0TB1Hfx4ja6Slr8S4EB3F1luYhATa1PKUSH8mYDW11HolzZmTQpRoLV8ZoHbHEaTfqX_aYahIw",
+            "e": "BQ"
+          }
+        ]
+      }
+)";
+  Jwks::LoadOptions options;
+  options.lazy = true;
+  auto jwks = Jwks::createFrom(jwks_text, Jwks::JWKS, options);
+  EXPECT_EQ(jwks->getStatus(), Status::Ok);
+  ASSERT_EQ(jwks->keys().size(), 1);
+  EXPECT_EQ(jwks->keys()[0]->materialize(), Status::JwksRsaParseError);
+  EXPECT_EQ(jwks->keys()[0]->rsa(), nullptr);
+  // The failure is sticky.
+  EXPECT_EQ(jwks->keys()[0]->materialize(), Status::JwksRsaParseError);
+}
+
+TEST(JwksParseTest, LazyMaterializeConcurrently) {
+  const std::string jwks_text = R"(
+      {
+        "keys": [
+          {
+            "kty": "EC",
+            "x": "EB54wykhS7YJFD6RYJNnwbWEz3cI7CF5bCDTXlrwI5k",
+            "y": "92bCBTvMFQ8lKbS2MbgjT3YfmYo6HnPEE2tsAqWUJw8"
+          }
+        ]
+      }
+)";
+  Jwks::LoadOptions options;
+  options.lazy = true;
+  auto jwks = Jwks::createFrom(jwks_text, Jwks::JWKS, options);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+
+  Jwks::Pubkey* key = jwks->keys()[0].get();
+  std::vector<std::thread> threads;
+  std::vector<Status> results(8, Status::JwksFetchFail);
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back(
+        [key, &results, i] { results[i] = key->materialize(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (Status status : results) {
+    EXPECT_EQ(status, Status::Ok);
+  }
+  EXPECT_NE(key->ec_key(), nullptr);
+}
+
+TEST(JwksParseTest, KeyMaterialAndMemoryUsage) {
+  const std::string jwks_text = R"(
+      {
+        "keys": [
+          {
+            "kty": "oct",
+            "kid": "oct",
+            "k": "LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl"
+          },
+          {
+            "kty": "EC",
+            "kid": "ec",
+            "x": "EB54wykhS7YJFD6RYJNnwbWEz3cI7CF5bCDTXlrwI5k",
+            "y": "92bCBTvMFQ8lKbS2MbgjT3YfmYo6HnPEE2tsAqWUJw8"
+          }
+        ]
+      }
+)";
+  auto jwks = Jwks::createFrom(jwks_text, Jwks::JWKS);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+  const Jwks::Pubkey& oct = *jwks->keys()[0];
+  EXPECT_EQ(oct.material(), Jwks::Pubkey::Material::Raw);
+  EXPECT_EQ(oct.raw_key().size(), 48);
+  EXPECT_EQ(oct.rsa(), nullptr);
+  EXPECT_EQ(oct.ec_key(), nullptr);
+  const Jwks::Pubkey& ec = *jwks->keys()[1];
+  EXPECT_EQ(ec.material(), Jwks::Pubkey::Material::EcKey);
+  EXPECT_TRUE(ec.raw_key().empty());
+
+  EXPECT_GE(jwks->memoryUsage(), oct.memoryUsage() + ec.memoryUsage());
+  EXPECT_GT(ec.memoryUsage(), sizeof(Jwks::Pubkey));
+
+  Jwks::LoadOptions options;
+  options.lazy = true;
+  auto lazy = Jwks::createFrom(jwks_text, Jwks::JWKS, options);
+  EXPECT_EQ(lazy->keys()[1]->material(), Jwks::Pubkey::Material::Lazy);
+  EXPECT_LT(lazy->memoryUsage(), jwks->memoryUsage());
+}
+
+// The RSA key of RFC 7638 section 3.1, whose thumbprint is
+// NzbLsXh8uDCcd-6MNwXF4W_7noWXFZAfHkxZsRGC9Xs.
+const std::string kPemRfc7638 = R"(
+-----BEGIN PUBLIC KEY-----
+MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEA0vx7agoebGcQSuuPiLJX
+ZptN9nndrQmbXEps2aiAFbWhM78LhWx4cbbfAAtVT86zwu1RK7aPFFxuhDR1L6tS
+oc/BJECPebWKRXjBZCiFV4n3oknjhMstn64tZ/2W+5JsGY4Hc5n9yBXArwl93lqt
+7/RN5w6Cf0h4QyQ5v+65YGjQR0/FDW2QvzqY368QQMicAtaSqzs8KJZgnYb9c7d0
+zgdAZHzu6qMQvRL5hajrn1n91CbOpbISD08qNLyrdkt+bFTWhAI4vMQFh6WeZu0f
+M4lFd2NcRwr3XPksINHaQ+G/xBniIqbw0Ls1jF44+csFCur+kEgU8awapJzKnqDK
+gwIDAQAB
+-----END PUBLIC KEY-----
+)";
+
+const std::string kPemEc256 = R"(
+-----BEGIN PUBLIC KEY-----
+MFkwEwYHKoZIzj0CAQYIKoZIzj0DAQcDQgAEQ4x/MTt08crvf9NsENzTH+XT3QdI
+HCLizGaWwk3uaY7jx93jqFGY5z1xlXe3zyPgEZATV3IjloAkT6uxN6A2YA==
+-----END PUBLIC KEY-----
+)";
+
+const std::string kPemCertificate = R"(
+-----BEGIN CERTIFICATE-----
+MIIC+jCCAeKgAwIBAgIIEN2Xgd3Y1CMwDQYJKoZIhvcNAQEFBQAwIDEeMBwGA1UE
+AxMVMTA2OTQ3MDEyMjYwNDg4NzM2MTU3MB4XDTE5MDIyNzE3NTA1N1oXDTI5MDIy
+NDE3NTA1N1owIDEeMBwGA1UEAxMVMTA2OTQ3MDEyMjYwNDg4NzM2MTU3MIIBIjAN
+BgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEA00bLFfPv/jeyVU6xuStcwHdSBa+m
+lOX/9oWFwMsQucENe+QYKJmkAqdATz3BKJ354iknMy556Y8cBHbZa9X6gxi2BIPW
+zkuKTruDJrQrg6cgR6RHZ9WNoxGLRtyhq8PimV8DVtMSLYVy3p/gMwEtuQY4jiXS
+hhvCZxuJZIJnabNqTU5AGWfduQgDcLRd25cShKxDNOtfcBWQ+ZQWt5qkZGz5XFQ/
+t1+bND+hA3dC3bwLc9yFrgU+Z+XEDQErq4OG9MVezw6h6Imn6gkrdSyG1k9BjPsf
+4senqDXgtK2Iz9MuGIWcG62wV2a7qJYjnGBJfI4QKQBEdsYbuUel2wB0wQIDAQAB
+ozgwNjAMBgNVHRMBAf8EAjAAMA4GA1UdDwEB/wQEAwIHgDAWBgNVHSUBAf8EDDAK
+BggrBgEFBQcDAjANBgkqhkiG9w0BAQUFAAOCAQEArrvMP0yrPQlCC/QB0iPxb4TY
+PPiDTuY4fPytUQgvSdQ4rMPSNZafe7tIS+0KDhZtblepaS5whVobVh9lS2bK+rDH
+RsM/H9XRGpyh2rJ6NYUbiyEMQ4jfNh99A02Nsz4Gaed3IE8Hml2pWLcCbp2VGDEN
+r6qrBVVWsaT736/kwVNp14S6FNhVIx1pZeKJrtOsJD+Y4f21WKlWdKdu4QVlxJoE
+9LtFur56aLhDA64D5GPjQnatRyShcWXvgEvUk5YUuBkjTDL1HSNTeqTdG6j8OEZo
+BuyfyPz4yV6BjnJWl2fk8v+9sB1B6m5LoR7ETHlWwh+elmaejFQCJN1+ED8k0w==
+-----END CERTIFICATE-----
+)";
+
+TEST(JwksParseTest, PemBundleWithThumbprintKids) {
+  auto jwks = Jwks::createFromPemBundle(kPemRfc7638 + kPemEc256 +
+                                        kPemCertificate);
+  EXPECT_EQ(jwks->getStatus(), Status::Ok);
+  ASSERT_EQ(jwks->keys().size(), 3);
+
+  EXPECT_EQ(jwks->keys()[0]->kty_, "RSA");
+  EXPECT_EQ(jwks->keys()[0]->kid_,
+            "NzbLsXh8uDCcd-6MNwXF4W_7noWXFZAfHkxZsRGC9Xs");
+  EXPECT_TRUE(jwks->keys()[0]->alg_.empty());
+  EXPECT_EQ(jwks->keys()[1]->kty_, "EC");
+  EXPECT_EQ(jwks->keys()[1]->kid_.size(), 43);
+  EXPECT_EQ(jwks->keys()[2]->kty_, "RSA");
+  EXPECT_EQ(jwks->keys()[2]->kid_.size(), 43);
+  EXPECT_NE(jwks->keys()[2]->rsa(), nullptr);
+}
+
+TEST(JwksParseTest, PemBundleWithSidecar) {
+  auto jwks = Jwks::createFromPemBundle(kPemRfc7638 + kPemEc256,
+                                        {{"rsa", "RS256"}, {"ec", "ES256"}});
+  EXPECT_EQ(jwks->getStatus(), Status::Ok);
+  ASSERT_EQ(jwks->keys().size(), 2);
+  EXPECT_EQ(jwks->keys()[0]->kid_, "rsa");
+  EXPECT_EQ(jwks->keys()[0]->alg_, "RS256");
+  EXPECT_EQ(jwks->keys()[1]->kid_, "ec");
+  EXPECT_EQ(jwks->keys()[1]->alg_, "ES256");
+  EXPECT_EQ(jwks->keys()[1]->crv_, "P-256");
+}
+
+TEST(JwksParseTest, PemBundleSkipsBadBlocks) {
+  const std::string bad_block = R"(
+-----BEGIN UNKNOWN-----
+AAAA
+-----END UNKNOWN-----
+)";
+  // The bad block keeps its place in the sidecar.
+  auto jwks = Jwks::createFromPemBundle(bad_block + kPemEc256,
+                                        {{"bad", ""}, {"ec", ""}});
+  EXPECT_EQ(jwks->getStatus(), Status::Ok);
+  ASSERT_EQ(jwks->keys().size(), 1);
+  EXPECT_EQ(jwks->keys()[0]->kid_, "ec");
+
+  jwks = Jwks::createFromPemBundle(bad_block);
+  EXPECT_EQ(jwks->getStatus(), Status::JwksPemBadBase64);
+
+  jwks = Jwks::createFromPemBundle("");
+  EXPECT_EQ(jwks->getStatus(), Status::JwksPemBadBase64);
+  EXPECT_TRUE(jwks->keys().empty());
+}
+
+// The base64 DER of kPemCertificate.
+std::string certificateBase64() {
+  return absl::StrReplaceAll(kPemCertificate,
+                             {{"-----BEGIN CERTIFICATE-----", ""},
+                              {"-----END CERTIFICATE-----", ""},
+                              {"\n", ""}});
+}
+
+TEST(JwksParseTest, ThumbprintsAtLoad) {
+  // The key of kPemCertificate, published with the certificate in "x5c", and
+  // an "oct" key.
+  const std::string jwks_text = absl::StrCat(R"(
+{
+  "keys": [
+    {
+      "kty": "RSA",
+      "kid": "rsa",
+      "n": "00bLFfPv_jeyVU6xuStcwHdSBa-mlOX_9oWFwMsQucENe-QYKJmkAqdATz3BKJ354iknMy556Y8cBHbZa9X6gxi2BIPWzkuKTruDJrQrg6cgR6RHZ9WNoxGLRtyhq8PimV8DVtMSLYVy3p_gMwEtuQY4jiXShhvCZxuJZIJnabNqTU5AGWfduQgDcLRd25cShKxDNOtfcBWQ-ZQWt5qkZGz5XFQ_t1-bND-hA3dC3bwLc9yFrgU-Z-XEDQErq4OG9MVezw6h6Imn6gkrdSyG1k9BjPsf4senqDXgtK2Iz9MuGIWcG62wV2a7qJYjnGBJfI4QKQBEdsYbuUel2wB0wQ",
+      "e": "AQAB",
+      "x5c": [")",
+                                             certificateBase64(), R"("]
+    },
+    {
+      "kty": "oct",
+      "kid": "oct",
+      "k": "LcHQCLETtc_QO4D69zSmL_TgqRJ2z3ewgsXL4oUKAhGEUhyIt1MhkaXRRaQNLNvl"
+    }
+  ]
+}
+)");
+  const std::string thumbprint = "2yMLeM0Au5zMrvGb7FjoFKcvbbgtXyu4Aq-hyQNmzj0";
+  const std::string x5t = "gs_Xl5AwY6C3jOHL9eL-A2pt4kI";
+  const std::string x5t_s256 = "0xUcnNGBDymQWdh14-w0pDceq0Nr4488YTc6sKtK6so";
+
+  Jwks::LoadOptions lazy;
+  lazy.lazy = true;
+  for (const auto& options : {Jwks::LoadOptions(), lazy}) {
+    auto jwks = Jwks::createFrom(jwks_text, Jwks::JWKS, options);
+    ASSERT_EQ(jwks->getStatus(), Status::Ok);
+    ASSERT_EQ(jwks->keys().size(), 2);
+    const Jwks::Pubkey* rsa = jwks->keys()[0].get();
+    EXPECT_EQ(rsa->thumbprint_, thumbprint);
+    EXPECT_EQ(rsa->x5t_, x5t);
+    EXPECT_EQ(rsa->x5t_s256_, x5t_s256);
+    EXPECT_EQ(jwks->findByThumbprint(thumbprint), rsa);
+    EXPECT_EQ(jwks->findByThumbprint(x5t), rsa);
+    EXPECT_EQ(jwks->findByThumbprint(x5t_s256), rsa);
+
+    // Secrets have no thumbprint.
+    EXPECT_TRUE(jwks->keys()[1]->thumbprint_.empty());
+    EXPECT_EQ(jwks->findByThumbprint(""), nullptr);
+    EXPECT_EQ(jwks->findByThumbprint("unknown"), nullptr);
+  }
+
+  // The same key from a certificate has the same thumbprint.
+  auto jwks = Jwks::createFromPemBundle(kPemCertificate);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+  EXPECT_EQ(jwks->keys()[0]->thumbprint_, thumbprint);
+
+  // A PEM public key has no certificate thumbprints.
+  jwks = Jwks::createFrom(kPemRfc7638, Jwks::PEM);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+  EXPECT_EQ(jwks->keys()[0]->thumbprint_,
+            "NzbLsXh8uDCcd-6MNwXF4W_7noWXFZAfHkxZsRGC9Xs");
+  EXPECT_TRUE(jwks->keys()[0]->x5t_s256_.empty());
+  EXPECT_EQ(jwks->findByThumbprint(jwks->keys()[0]->thumbprint_),
+            jwks->keys()[0].get());
+
+  // Keys added later are found as well.
+  EXPECT_EQ(jwks->addKeyFromPem(kPemEc256, "ec", "ES256"), Status::Ok);
+  EXPECT_EQ(jwks->findByThumbprint(jwks->keys()[1]->thumbprint_),
+            jwks->keys()[1].get());
+}
+
+TEST(JwksParseTest, CertificateOfAnotherKey) {
+  // The key of kPemRfc7638, published with kPemCertificate, which holds
+  // another key.
+  const std::string jwks_text = absl::StrCat(R"(
+{
+  "keys": [
+    {
+      "kty": "RSA",
+      "n": "0vx7agoebGcQSuuPiLJXZptN9nndrQmbXEps2aiAFbWhM78LhWx4cbbfAAtVT86zwu1RK7aPFFxuhDR1L6tSoc_BJECPebWKRXjBZCiFV4n3oknjhMstn64tZ_2W-5JsGY4Hc5n9yBXArwl93lqt7_RN5w6Cf0h4QyQ5v-65YGjQR0_FDW2QvzqY368QQMicAtaSqzs8KJZgnYb9c7d0zgdAZHzu6qMQvRL5hajrn1n91CbOpbISD08qNLyrdkt-bFTWhAI4vMQFh6WeZu0fM4lFd2NcRwr3XPksINHaQ-G_xBniIqbw0Ls1jF44-csFCur-kEgU8awapJzKnqDKgw",
+      "e": "AQAB",
+      "x5c": [")",
+                                             certificateBase64(), R"("]
+    }
+  ]
+}
+)");
+  Jwks::LoadOptions lazy;
+  lazy.lazy = true;
+  for (const auto& options : {Jwks::LoadOptions(), lazy}) {
+    auto jwks = Jwks::createFrom(jwks_text, Jwks::JWKS, options);
+    ASSERT_EQ(jwks->getStatus(), Status::Ok);
+    const Jwks::Pubkey* rsa = jwks->keys()[0].get();
+    EXPECT_EQ(rsa->thumbprint_, "NzbLsXh8uDCcd-6MNwXF4W_7noWXFZAfHkxZsRGC9Xs");
+    EXPECT_TRUE(rsa->x5t_.empty());
+    EXPECT_TRUE(rsa->x5t_s256_.empty());
+    EXPECT_EQ(jwks->findByThumbprint("gs_Xl5AwY6C3jOHL9eL-A2pt4kI"), nullptr);
+    EXPECT_EQ(
+        jwks->findByThumbprint("0xUcnNGBDymQWdh14-w0pDceq0Nr4488YTc6sKtK6so"),
+        nullptr);
+  }
+}
+
+TEST(JwksParseTest, ThumbprintsAreCanonical) {
+  // The "n" of kPemRfc7638.
+  const std::string n =
+      "0vx7agoebGcQSuuPiLJXZptN9nndrQmbXEps2aiAFbWhM78LhWx4cbbfAAtVT86zwu1R"
+      "K7aPFFxuhDR1L6tSoc_BJECPebWKRXjBZCiFV4n3oknjhMstn64tZ_2W-5JsGY4Hc5n9"
+      "yBXArwl93lqt7_RN5w6Cf0h4QyQ5v-65YGjQR0_FDW2QvzqY368QQMicAtaSqzs8KJZg"
+      "nYb9c7d0zgdAZHzu6qMQvRL5hajrn1n91CbOpbISD08qNLyrdkt-bFTWhAI4vMQFh6We"
+      "Zu0fM4lFd2NcRwr3XPksINHaQ-G_xBniIqbw0Ls1jF44-csFCur-kEgU8awapJzKnqDK"
+      "gw";
+  const std::string thumbprint = "NzbLsXh8uDCcd-6MNwXF4W_7noWXFZAfHkxZsRGC9Xs";
+
+  // The same key with a leading zero octet in "n" and "e".
+  std::string n_bytes;
+  ASSERT_TRUE(absl::WebSafeBase64Unescape(n, &n_bytes));
+  const std::string jwks_text = absl::StrCat(
+      R"({"keys": [{"kty": "RSA", "e": "AAEAAQ", "n": ")",
+      absl::WebSafeBase64Escape(std::string(1, '\0') + n_bytes), R"("}]})");
+  Jwks::LoadOptions lazy;
+  lazy.lazy = true;
+  for (const auto& options : {Jwks::LoadOptions(), lazy}) {
+    auto jwks = Jwks::createFrom(jwks_text, Jwks::JWKS, options);
+    ASSERT_EQ(jwks->getStatus(), Status::Ok);
+    EXPECT_EQ(jwks->keys()[0]->thumbprint_, thumbprint);
+  }
+
+  // Padding does not change it either.
+  EXPECT_EQ(Jwks::computeThumbprint({"RSA", "", "AQAB", n + "=="}), thumbprint);
+  EXPECT_EQ(Jwks::computeThumbprint({"RSA", "", "AQAB", "not base64!"}), "");
+}
+
+TEST(JwksParseTest, CertificateThumbprints) {
+  auto jwks = Jwks::createFromPemBundle(kPemCertificate);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+  EXPECT_EQ(jwks->keys()[0]->x5t_, "gs_Xl5AwY6C3jOHL9eL-A2pt4kI");
+  EXPECT_EQ(jwks->keys()[0]->x5t_s256_,
+            "0xUcnNGBDymQWdh14-w0pDceq0Nr4488YTc6sKtK6so");
+  EXPECT_EQ(jwks->findByThumbprint(jwks->keys()[0]->x5t_s256_),
+            jwks->keys()[0].get());
+
+  // Keys of an x509 key map have the thumbprints of their certificates,
+  // whether or not the certificate is kept.
+  Jwks::LoadOptions retain;
+  retain.retain_x509 = true;
+  for (const auto& options : {Jwks::LoadOptions(), retain}) {
+    jwks = Jwks::createFrom(kPublicKeyX509, Jwks::JWKS, options);
+    ASSERT_EQ(jwks->getStatus(), Status::Ok);
+    for (const auto& key : jwks->keys()) {
+      EXPECT_EQ(key->thumbprint_.size(), 43);
+      EXPECT_EQ(key->x5t_.size(), 27);
+      EXPECT_EQ(key->x5t_s256_.size(), 43);
+      EXPECT_EQ(jwks->findByThumbprint(key->x5t_s256_), key.get());
+    }
+  }
+}
+
 }  // namespace
 }  // namespace jwt_verify
 }  // namespace google
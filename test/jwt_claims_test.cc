@@ -0,0 +1,394 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/jwt_claims.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include "absl/strings/str_cat.h"
+#include "google/protobuf/util/json_util.h"
+#include "gtest/gtest.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+const std::string Payload = R"({
+  "iss": "https://example.com",
+  "escaped": "a\nb",
+  "num": 1501281000.7,
+  "negative": -1,
+  "huge": 1e30,
+  "flag": true,
+  "nothing": null,
+  "aud": ["aud1", "aud2"],
+  "mixed": ["a", 1],
+  "nested": {"inner": {"value": "deep"}, "list": "one"},
+  "dotted.name": "x"
+})";
+
+TEST(JwtClaimsTest, IndexesMembers) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  ASSERT_EQ(claims.claims().size(), 11);
+  EXPECT_EQ(claims.claims()[0].name, "iss");
+  EXPECT_EQ(claims.claims()[0].type, JsonReader::Type::String);
+  EXPECT_EQ(claims.claims()[2].value, "1501281000.7");
+  EXPECT_EQ(claims.claims()[9].type, JsonReader::Type::Object);
+}
+
+TEST(JwtClaimsTest, StringsAreViews) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  absl::string_view value;
+  ASSERT_EQ(claims.GetString("iss", &value), StructUtils::OK);
+  EXPECT_EQ(value, "https://example.com");
+  EXPECT_GE(value.data(), Payload.data());
+  EXPECT_LT(value.data(), Payload.data() + Payload.size());
+
+  // Strings with escapes are decoded.
+  ASSERT_EQ(claims.GetString("escaped", &value), StructUtils::OK);
+  EXPECT_EQ(value, "a\nb");
+}
+
+TEST(JwtClaimsTest, MatchesStructUtils) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  ::google::protobuf::Struct payload_pb;
+  ASSERT_TRUE(
+      ::google::protobuf::util::JsonStringToMessage(Payload, &payload_pb).ok());
+  StructUtils struct_getter(payload_pb);
+
+  const std::vector<std::string> names = {
+      "iss",          "escaped",          "num",      "negative",
+      "huge",         "flag",             "nothing",  "aud",
+      "mixed",        "nested",           "missing",  "nested.inner.value",
+      "nested.list",  "nested.list.more", "iss.more", "nested.missing",
+      "dotted.name",  "",                 "nested.",  ".iss",
+  };
+  for (const auto& name : names) {
+    std::string claims_str, struct_str;
+    EXPECT_EQ(claims.GetString(name, &claims_str),
+              struct_getter.GetString(name, &struct_str))
+        << name;
+    EXPECT_EQ(claims_str, struct_str) << name;
+
+    uint64_t claims_int = 0, struct_int = 0;
+    EXPECT_EQ(claims.GetUInt64(name, &claims_int),
+              struct_getter.GetUInt64(name, &struct_int))
+        << name;
+    EXPECT_EQ(claims_int, struct_int) << name;
+
+    double claims_double = 0, struct_double = 0;
+    EXPECT_EQ(claims.GetDouble(name, &claims_double),
+              struct_getter.GetDouble(name, &struct_double))
+        << name;
+    EXPECT_EQ(claims_double, struct_double) << name;
+
+    bool claims_bool = false, struct_bool = false;
+    EXPECT_EQ(claims.GetBoolean(name, &claims_bool),
+              struct_getter.GetBoolean(name, &struct_bool))
+        << name;
+    EXPECT_EQ(claims_bool, struct_bool) << name;
+
+    std::vector<std::string> claims_list, struct_list;
+    EXPECT_EQ(claims.GetStringList(name, &claims_list),
+              struct_getter.GetStringList(name, &struct_list))
+        << name;
+    EXPECT_EQ(claims_list, struct_list) << name;
+  }
+}
+
+TEST(JwtClaimsTest, ClaimPathMatchesNames) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  ::google::protobuf::Struct payload_pb;
+  ASSERT_TRUE(
+      ::google::protobuf::util::JsonStringToMessage(Payload, &payload_pb).ok());
+  StructUtils struct_getter(payload_pb);
+
+  const std::vector<std::string> names = {
+      "iss",         "num",    "flag",    "aud",        "nested.inner.value",
+      "nested.list", "nested", "missing", "iss.more",   "nested.missing",
+      "dotted.name", "",       "nested.", "nested.inner",
+  };
+  for (const auto& name : names) {
+    const ClaimPath path(name);
+    EXPECT_EQ(path.path(), name);
+
+    const JwtClaims::Claim* by_name = nullptr;
+    const JwtClaims::Claim* by_path = nullptr;
+    EXPECT_EQ(claims.GetValue(path, by_path), claims.GetValue(name, by_name))
+        << name;
+    EXPECT_EQ(by_path, by_name) << name;
+
+    const JwtClaims* object_by_name = nullptr;
+    const JwtClaims* object_by_path = nullptr;
+    EXPECT_EQ(claims.GetObject(path, object_by_path),
+              claims.GetObject(name, object_by_name))
+        << name;
+    EXPECT_EQ(object_by_path, object_by_name) << name;
+
+    std::string claims_str, struct_str;
+    EXPECT_EQ(claims.GetString(path, &claims_str),
+              struct_getter.GetString(path, &struct_str))
+        << name;
+    EXPECT_EQ(claims_str, struct_str) << name;
+
+    uint64_t claims_int = 0, struct_int = 0;
+    EXPECT_EQ(claims.GetUInt64(path, &claims_int),
+              struct_getter.GetUInt64(path, &struct_int))
+        << name;
+    EXPECT_EQ(claims_int, struct_int) << name;
+
+    bool claims_bool = false, struct_bool = false;
+    EXPECT_EQ(claims.GetBoolean(path, &claims_bool),
+              struct_getter.GetBoolean(path, &struct_bool))
+        << name;
+    EXPECT_EQ(claims_bool, struct_bool) << name;
+
+    std::vector<std::string> claims_list, struct_list;
+    EXPECT_EQ(claims.GetStringList(path, &claims_list),
+              struct_getter.GetStringList(path, &struct_list))
+        << name;
+    EXPECT_EQ(claims_list, struct_list) << name;
+
+    const google::protobuf::Value* value_by_name = nullptr;
+    const google::protobuf::Value* value_by_path = nullptr;
+    EXPECT_EQ(struct_getter.GetValue(path, value_by_path),
+              struct_getter.GetValue(name, value_by_name))
+        << name;
+    EXPECT_EQ(value_by_path, value_by_name) << name;
+  }
+}
+
+TEST(JwtClaimsTest, ClaimPathIsReusable) {
+  const ClaimPath path("nested.inner.value");
+  EXPECT_EQ(path.names(),
+            std::vector<std::string>({"nested", "inner", "value"}));
+
+  for (absl::string_view value : {"one", "two"}) {
+    const std::string payload =
+        absl::StrCat(R"({"nested": {"inner": {"value": ")", value, R"("}}})");
+    JwtClaims claims;
+    ASSERT_TRUE(claims.parse(payload));
+    absl::string_view found;
+    EXPECT_EQ(claims.GetString(path, &found), StructUtils::OK);
+    EXPECT_EQ(found, value);
+  }
+}
+
+TEST(JwtClaimsTest, IntegersAreExact) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(R"({
+    "above_2_53": 9007199254740993,
+    "uint64_max": 18446744073709551615,
+    "uint64_over": 18446744073709551616,
+    "int64_min": -9223372036854775808,
+    "int64_under": -9223372036854775809,
+    "exponent": 1.5e3,
+    "big_exponent": 1e19,
+    "fraction": 1501281000.999,
+    "small": 5e-1,
+    "underflow": -1e-400,
+    "negative_fraction": -0.5,
+    "negative_zero": -0.0,
+    "string": "1"
+  })"));
+
+  struct {
+    const char* name;
+    StructUtils::FindResult uint64_result;
+    uint64_t uint64_value;
+    StructUtils::FindResult int64_result;
+    int64_t int64_value;
+  } cases[] = {
+      {"above_2_53", StructUtils::OK, 9007199254740993ULL, StructUtils::OK,
+       9007199254740993LL},
+      {"uint64_max", StructUtils::OK, 18446744073709551615ULL,
+       StructUtils::OUT_OF_RANGE, 0},
+      {"uint64_over", StructUtils::OUT_OF_RANGE, 0, StructUtils::OUT_OF_RANGE,
+       0},
+      {"int64_min", StructUtils::OUT_OF_RANGE, 0, StructUtils::OK,
+       std::numeric_limits<int64_t>::min()},
+      {"int64_under", StructUtils::OUT_OF_RANGE, 0, StructUtils::OUT_OF_RANGE,
+       0},
+      {"exponent", StructUtils::OK, 1500, StructUtils::OK, 1500},
+      {"big_exponent", StructUtils::OK, 10000000000000000000ULL,
+       StructUtils::OUT_OF_RANGE, 0},
+      {"fraction", StructUtils::OK, 1501281000, StructUtils::OK, 1501281000},
+      {"small", StructUtils::OK, 0, StructUtils::OK, 0},
+      {"underflow", StructUtils::OK, 0, StructUtils::OK, 0},
+      {"negative_fraction", StructUtils::OUT_OF_RANGE, 0, StructUtils::OK, 0},
+      {"negative_zero", StructUtils::OK, 0, StructUtils::OK, 0},
+      {"string", StructUtils::WRONG_TYPE, 0, StructUtils::WRONG_TYPE, 0},
+      {"missing", StructUtils::MISSING, 0, StructUtils::MISSING, 0},
+  };
+  for (const auto& test : cases) {
+    uint64_t uint64_value = 0;
+    EXPECT_EQ(claims.GetUInt64(test.name, &uint64_value), test.uint64_result)
+        << test.name;
+    if (test.uint64_result == StructUtils::OK) {
+      EXPECT_EQ(uint64_value, test.uint64_value) << test.name;
+    }
+    int64_t int64_value = 0;
+    EXPECT_EQ(claims.GetInt64(test.name, &int64_value), test.int64_result)
+        << test.name;
+    if (test.int64_result == StructUtils::OK) {
+      EXPECT_EQ(int64_value, test.int64_value) << test.name;
+    }
+  }
+}
+
+TEST(JwtClaimsTest, GetObject) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  const JwtClaims* nested;
+  ASSERT_EQ(claims.GetObject("nested.inner", nested), StructUtils::OK);
+  std::string value;
+  EXPECT_EQ(nested->GetString("value", &value), StructUtils::OK);
+  EXPECT_EQ(value, "deep");
+
+  // Nested objects are indexed once.
+  const JwtClaims* again;
+  ASSERT_EQ(claims.GetObject("nested.inner", again), StructUtils::OK);
+  EXPECT_EQ(nested, again);
+
+  EXPECT_EQ(claims.GetObject("iss", nested), StructUtils::WRONG_TYPE);
+  EXPECT_EQ(claims.GetObject("missing", nested), StructUtils::MISSING);
+}
+
+TEST(JwtClaimsTest, Contains) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  const ClaimPath inner("nested.inner.value");
+
+  struct {
+    std::string name;
+    std::string value;
+    StructUtils::FindResult result;
+    bool contained;
+  } cases[] = {
+      {"aud", "aud1", StructUtils::OK, true},
+      {"aud", "aud2", StructUtils::OK, true},
+      {"aud", "aud", StructUtils::OK, false},
+      {"iss", "https://example.com", StructUtils::OK, true},
+      {"iss", "https://example.org", StructUtils::OK, false},
+      {"escaped", "a\nb", StructUtils::OK, true},
+      {"escaped", "a\\nb", StructUtils::OK, false},
+      {"nested.list", "one", StructUtils::OK, true},
+      {"nested.inner.value", "deep", StructUtils::OK, true},
+      {"mixed", "a", StructUtils::WRONG_TYPE, false},
+      {"num", "1501281000.7", StructUtils::WRONG_TYPE, false},
+      {"nested", "inner", StructUtils::WRONG_TYPE, false},
+      {"missing", "a", StructUtils::MISSING, false},
+      {"iss.more", "a", StructUtils::WRONG_TYPE, false},
+  };
+  for (const auto& test : cases) {
+    bool contained = false;
+    EXPECT_EQ(claims.Contains(test.name, test.value, &contained), test.result)
+        << test.name;
+    EXPECT_EQ(contained, test.contained) << test.name << " " << test.value;
+
+    // Same as a scan of GetStringList.
+    std::vector<std::string> list;
+    EXPECT_EQ(claims.GetStringList(test.name, &list), test.result) << test.name;
+    if (test.result == StructUtils::OK) {
+      EXPECT_EQ(std::find(list.begin(), list.end(), test.value) != list.end(),
+                test.contained)
+          << test.name;
+    }
+  }
+
+  bool contained = false;
+  EXPECT_EQ(claims.Contains(inner, "deep", &contained), StructUtils::OK);
+  EXPECT_TRUE(contained);
+}
+
+TEST(JwtClaimsTest, ContainsLargeArray) {
+  std::string payload = R"({"groups": [)";
+  for (int i = 0; i < 1000; ++i) {
+    payload += (i == 0 ? "" : ",") + ("\"group-" + std::to_string(i) + "\"");
+  }
+  // An escaped element is decoded.
+  payload += R"(, "esc\u0061ped"]})";
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(payload));
+
+  for (int i = 0; i < 1000; ++i) {
+    bool contained = false;
+    ASSERT_EQ(claims.Contains("groups", "group-" + std::to_string(i),
+                              &contained),
+              StructUtils::OK);
+    EXPECT_TRUE(contained) << i;
+  }
+  bool contained = true;
+  EXPECT_EQ(claims.Contains("groups", "group-1000", &contained),
+            StructUtils::OK);
+  EXPECT_FALSE(contained);
+  EXPECT_EQ(claims.Contains("groups", "escaped", &contained), StructUtils::OK);
+  EXPECT_TRUE(contained);
+
+  // The sets are dropped with the index.
+  ASSERT_TRUE(claims.parse(R"({"groups": ["other"]})"));
+  EXPECT_EQ(claims.Contains("groups", "group-1", &contained), StructUtils::OK);
+  EXPECT_FALSE(contained);
+  EXPECT_EQ(claims.Contains("groups", "other", &contained), StructUtils::OK);
+  EXPECT_TRUE(contained);
+}
+
+TEST(JwtClaimsTest, LookupsFromThreads) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  const JwtClaims& shared = claims;
+  const ClaimPath inner("nested.inner.value");
+
+  // Each thread may be the one to build the nested indexes and the sets.
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      for (int round = 0; round < 100; ++round) {
+        absl::string_view value;
+        EXPECT_EQ(shared.GetString(inner, &value), StructUtils::OK);
+        EXPECT_EQ(value, "deep");
+        bool contained = false;
+        EXPECT_EQ(shared.Contains("aud", "aud2", &contained), StructUtils::OK);
+        EXPECT_TRUE(contained);
+        contained = false;
+        EXPECT_EQ(shared.Contains("nested.list", "one", &contained),
+                  StructUtils::OK);
+        EXPECT_TRUE(contained);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(JwtClaimsTest, BadJson) {
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(Payload));
+  EXPECT_FALSE(claims.parse(R"({"a": 1, "a": 2})"));
+  EXPECT_TRUE(claims.claims().empty());
+  EXPECT_FALSE(claims.parse(R"({"a": {"b": })"));
+  EXPECT_FALSE(claims.parse("[]"));
+  EXPECT_FALSE(claims.parse(""));
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
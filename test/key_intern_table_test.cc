@@ -0,0 +1,180 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/key_intern_table.h"
+
+#include "gtest/gtest.h"
+#include "jwt_verify_lib/jwks.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+// The public key of verify_pem_rsa_test in JWK format.
+const std::string RsaJwks = R"(
+{
+  "keys": [
+    {
+      "kty": "RSA",
+      "alg": "RS256",
+      "kid": "rsa",
+      "n": "zgP9Xw2xvul2pZNjCpJD_L16FmKH_zt53seeo2_eBKzcUs3nDO33aYdjsCAAFaQfXSAe0PfmwbytmH9RMHOJPUU2ApcEt63K5-3v5n-kqKfmym2lOebqpLgsdXIXvTsHYYy_10GGM-NPgyMUgU8qJSaPOOA_ZJ1eWQTyfgJCPeIarzcTaf-eSD3CQaDDpi488RFc3O86pho5x3KTHSg4CxHp0ua1RV2pNGJP1BqN0oX09Rgpjo7GE-ukpCMO7zOCwSeBjnqL_zdJ7pjo__u0dhGpdbcejNZhl1NN-0q1eogwJPM295_7xRSW77mmcUI8W4oLDHLz1zxRoX9yK9xv3w",
+      "e": "AQAB"
+    }
+  ]
+}
+)";
+
+const std::string RsaPem = R"(
+-----BEGIN PUBLIC KEY-----
+MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEAzgP9Xw2xvul2pZNjCpJD
+/L16FmKH/zt53seeo2/eBKzcUs3nDO33aYdjsCAAFaQfXSAe0PfmwbytmH9RMHOJ
+PUU2ApcEt63K5+3v5n+kqKfmym2lOebqpLgsdXIXvTsHYYy/10GGM+NPgyMUgU8q
+JSaPOOA/ZJ1eWQTyfgJCPeIarzcTaf+eSD3CQaDDpi488RFc3O86pho5x3KTHSg4
+CxHp0ua1RV2pNGJP1BqN0oX09Rgpjo7GE+ukpCMO7zOCwSeBjnqL/zdJ7pjo//u0
+dhGpdbcejNZhl1NN+0q1eogwJPM295/7xRSW77mmcUI8W4oLDHLz1zxRoX9yK9xv
+3wIDAQAB
+-----END PUBLIC KEY-----
+)";
+
+const std::string EcJwks = R"(
+{
+  "keys": [
+    {
+      "kty": "EC",
+      "crv": "P-256",
+      "x": "EB54wykhS7YJFD6RYJNnwbWEz3cI7CF5bCDTXlrwI5k",
+      "y": "92bCBTvMFQ8lKbS2MbgjT3YfmYo6HnPEE2tsAqWUJw8",
+      "alg": "ES256",
+      "kid": "ec"
+    }
+  ]
+}
+)";
+
+const std::string EcJwks2 = R"(
+{
+  "keys": [
+    {
+      "kty": "EC",
+      "crv": "P-384",
+      "x": "yY8DWcyWlrr93FTrscI5Ydz2NC7emfoKYHJLX2dr3cSgfw0GuxAkuQ5nBMJmVV5g",
+      "y": "An5wVxEfksDOa_zvSHHGkeYJUfl8y11wYkOlFjBt9pOCw5-RlfZgPOa3pbmUquxZ",
+      "alg": "ES384",
+      "kid": "ec2"
+    }
+  ]
+}
+)";
+
+// An RSA public key with n = 257 and e = 65537, which RSA_check_key rejects
+// as n is below e.
+const std::string InvalidRsaPem = R"(
+-----BEGIN PUBLIC KEY-----
+MB0wDQYJKoZIhvcNAQEBBQADDAAwCQICAQECAwEAAQ==
+-----END PUBLIC KEY-----
+)";
+
+const std::string InvalidRsaJwks = R"(
+{
+  "keys": [
+    {
+      "kty": "RSA",
+      "alg": "RS256",
+      "kid": "invalid",
+      "n": "AQE",
+      "e": "AQAB"
+    }
+  ]
+}
+)";
+
+class KeyInternTableTest : public testing::Test {
+ protected:
+  void SetUp() override { KeyInternTable::global().setMaxEntries(100); }
+  void TearDown() override { KeyInternTable::global().setMaxEntries(0); }
+};
+
+TEST_F(KeyInternTableTest, SharesRsaKeyAcrossJwks) {
+  auto jwks1 = Jwks::createFrom(RsaJwks, Jwks::JWKS);
+  auto jwks2 = Jwks::createFrom(RsaJwks, Jwks::JWKS);
+  auto pem = Jwks::createFrom(RsaPem, Jwks::PEM);
+  ASSERT_EQ(jwks1->getStatus(), Status::Ok);
+  ASSERT_EQ(jwks2->getStatus(), Status::Ok);
+  ASSERT_EQ(pem->getStatus(), Status::Ok);
+
+  EXPECT_EQ(jwks1->keys()[0]->rsa(), jwks2->keys()[0]->rsa());
+  EXPECT_EQ(jwks1->keys()[0]->rsa(), pem->keys()[0]->rsa());
+  EXPECT_EQ(KeyInternTable::global().entries(), 1);
+
+  // The shared key outlives the Jwks it was loaded by.
+  jwks1.reset();
+  KeyInternTable::global().setMaxEntries(0);
+  EXPECT_NE(RSA_size(jwks2->keys()[0]->rsa()), 0);
+}
+
+TEST_F(KeyInternTableTest, PemKeyDoesNotSkipRsaCheck) {
+  // PEM keys are interned without RSA_check_key. Some SSL libraries reject
+  // the key while parsing it already.
+  auto pem = Jwks::createFrom(InvalidRsaPem, Jwks::PEM);
+  auto jwks = Jwks::createFrom(InvalidRsaJwks, Jwks::JWKS);
+  EXPECT_EQ(jwks->getStatus(), Status::JwksRsaParseError);
+}
+
+TEST_F(KeyInternTableTest, CheckedKeyIsShared) {
+  // A PEM key interned first is shared once a JWKS load checked it.
+  auto pem = Jwks::createFrom(RsaPem, Jwks::PEM);
+  auto jwks1 = Jwks::createFrom(RsaJwks, Jwks::JWKS);
+  auto jwks2 = Jwks::createFrom(RsaJwks, Jwks::JWKS);
+  ASSERT_EQ(pem->getStatus(), Status::Ok);
+  ASSERT_EQ(jwks1->getStatus(), Status::Ok);
+  ASSERT_EQ(jwks2->getStatus(), Status::Ok);
+  EXPECT_EQ(pem->keys()[0]->rsa(), jwks1->keys()[0]->rsa());
+  EXPECT_EQ(jwks1->keys()[0]->rsa(), jwks2->keys()[0]->rsa());
+  EXPECT_EQ(KeyInternTable::global().entries(), 1);
+}
+
+TEST_F(KeyInternTableTest, SharesEcKeyAcrossJwks) {
+  auto jwks1 = Jwks::createFrom(EcJwks, Jwks::JWKS);
+  auto jwks2 = Jwks::createFrom(EcJwks, Jwks::JWKS);
+  ASSERT_EQ(jwks1->getStatus(), Status::Ok);
+  ASSERT_EQ(jwks2->getStatus(), Status::Ok);
+  EXPECT_EQ(jwks1->keys()[0]->ec_key(), jwks2->keys()[0]->ec_key());
+}
+
+TEST_F(KeyInternTableTest, DisabledKeepsKeysSeparate) {
+  KeyInternTable::global().setMaxEntries(0);
+  EXPECT_FALSE(KeyInternTable::global().enabled());
+  auto jwks1 = Jwks::createFrom(RsaJwks, Jwks::JWKS);
+  auto jwks2 = Jwks::createFrom(RsaJwks, Jwks::JWKS);
+  EXPECT_NE(jwks1->keys()[0]->rsa(), jwks2->keys()[0]->rsa());
+  EXPECT_EQ(KeyInternTable::global().entries(), 0);
+}
+
+TEST_F(KeyInternTableTest, BoundedEntries) {
+  KeyInternTable::global().setMaxEntries(1);
+  auto rsa = Jwks::createFrom(RsaJwks, Jwks::JWKS);
+  auto ec = Jwks::createFrom(EcJwks, Jwks::JWKS);
+  auto ec2 = Jwks::createFrom(EcJwks2, Jwks::JWKS);
+  EXPECT_EQ(KeyInternTable::global().entries(), 1);
+
+  // The evicted RSA key is not shared anymore, but keeps working.
+  auto rsa2 = Jwks::createFrom(RsaJwks, Jwks::JWKS);
+  EXPECT_NE(rsa->keys()[0]->rsa(), rsa2->keys()[0]->rsa());
+  EXPECT_NE(RSA_size(rsa->keys()[0]->rsa()), 0);
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
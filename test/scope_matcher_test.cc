@@ -0,0 +1,138 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/scope_matcher.h"
+
+#include "gtest/gtest.h"
+#include "test/allocation_counter.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+TEST(ScopeMatcherTest, ParsesScopes) {
+  const ScopeMatcher matcher({"read", "write", "admin"});
+  ASSERT_EQ(matcher.size(), 3);
+
+  ScopeMatcher::Scopes scopes;
+  matcher.parse("  write read  openid read ", &scopes);
+  EXPECT_TRUE(scopes.has(0));
+  EXPECT_TRUE(scopes.has(1));
+  EXPECT_FALSE(scopes.has(2));
+  EXPECT_FALSE(scopes.has(3));
+  EXPECT_EQ(scopes.unknown(), 1);
+
+  // Parsing again replaces the scopes.
+  matcher.parse("admin", &scopes);
+  EXPECT_FALSE(scopes.has(0));
+  EXPECT_TRUE(scopes.has(2));
+  EXPECT_EQ(scopes.unknown(), 0);
+
+  matcher.parse("", &scopes);
+  EXPECT_FALSE(scopes.has(2));
+}
+
+TEST(ScopeMatcherTest, AllAndAny) {
+  const ScopeMatcher matcher({"read", "write", "admin"});
+  const auto read_write = matcher.compile({"read", "write"});
+  const auto admin = matcher.compile({"admin"});
+  const auto unknown = matcher.compile({"read", "other"});
+  EXPECT_EQ(unknown.unknown(), 1);
+
+  ScopeMatcher::Scopes scopes;
+  matcher.parse("read write", &scopes);
+  EXPECT_TRUE(scopes.hasAll(read_write));
+  EXPECT_TRUE(scopes.hasAny(read_write));
+  EXPECT_FALSE(scopes.hasAll(admin));
+  EXPECT_FALSE(scopes.hasAny(admin));
+  // No token has a scope that is not in the vocabulary.
+  EXPECT_FALSE(scopes.hasAll(unknown));
+  EXPECT_TRUE(scopes.hasAny(unknown));
+
+  matcher.parse("read", &scopes);
+  EXPECT_FALSE(scopes.hasAll(read_write));
+  EXPECT_TRUE(scopes.hasAny(read_write));
+
+  // Nothing is required.
+  EXPECT_TRUE(scopes.hasAll(matcher.compile({})));
+  EXPECT_FALSE(scopes.hasAny(matcher.compile({})));
+}
+
+TEST(ScopeMatcherTest, LargeVocabulary) {
+  std::vector<std::string> vocabulary;
+  for (int i = 0; i < 200; ++i) {
+    vocabulary.push_back("scope" + std::to_string(i));
+  }
+  const ScopeMatcher matcher(vocabulary);
+  const auto required = matcher.compile({"scope0", "scope64", "scope199"});
+
+  ScopeMatcher::Scopes scopes;
+  matcher.parse("scope199 scope64 scope0 scope200", &scopes);
+  EXPECT_TRUE(scopes.hasAll(required));
+  EXPECT_TRUE(scopes.has(199));
+  EXPECT_FALSE(scopes.has(198));
+  EXPECT_EQ(scopes.unknown(), 1);
+
+  matcher.parse("scope0 scope64", &scopes);
+  EXPECT_FALSE(scopes.hasAll(required));
+  EXPECT_TRUE(scopes.hasAny(required));
+}
+
+TEST(ScopeMatcherTest, MatchClaims) {
+  const ScopeMatcher matcher({"read", "write"});
+  const ScopeMatcher nested({"read", "write"}, "access.scp");
+  const auto read_write = matcher.compile({"read", "write"});
+  JwtClaims claims;
+  ScopeMatcher::Scopes scopes;
+
+  ASSERT_TRUE(claims.parse(R"({"scope": "write read"})"));
+  EXPECT_EQ(matcher.match(claims, &scopes), StructUtils::OK);
+  EXPECT_TRUE(scopes.hasAll(read_write));
+  EXPECT_EQ(nested.match(claims, &scopes), StructUtils::MISSING);
+  EXPECT_FALSE(scopes.hasAny(read_write));
+
+  ASSERT_TRUE(claims.parse(R"({"access": {"scp": ["read", "write"]}})"));
+  EXPECT_EQ(nested.match(claims, &scopes), StructUtils::OK);
+  EXPECT_TRUE(scopes.hasAll(read_write));
+
+  ASSERT_TRUE(claims.parse(R"({"scope": ["read", 1]})"));
+  EXPECT_EQ(matcher.match(claims, &scopes), StructUtils::WRONG_TYPE);
+  EXPECT_FALSE(scopes.hasAny(read_write));
+
+  ASSERT_TRUE(claims.parse(R"({"scope": true})"));
+  EXPECT_EQ(matcher.match(claims, &scopes), StructUtils::WRONG_TYPE);
+}
+
+TEST(ScopeMatcherTest, MatchDoesNotAllocate) {
+  const ScopeMatcher matcher({"read", "write"});
+  const ScopeMatcher list({"read", "write"}, "scp");
+  JwtClaims claims;
+  ASSERT_TRUE(claims.parse(
+      R"({"scope": "read write other", "scp": ["read", "write", "other"]})"));
+  ScopeMatcher::Scopes scopes;
+  // The first match grows scopes.
+  ASSERT_EQ(matcher.match(claims, &scopes), StructUtils::OK);
+
+  const size_t allocations = allocationCount();
+  EXPECT_EQ(matcher.match(claims, &scopes), StructUtils::OK);
+  EXPECT_TRUE(scopes.has(1));
+  EXPECT_EQ(list.match(claims, &scopes), StructUtils::OK);
+  EXPECT_TRUE(scopes.has(1));
+  EXPECT_EQ(scopes.unknown(), 1);
+  EXPECT_EQ(allocationCount(), allocations);
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
@@ -0,0 +1,130 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/validated_key_cache.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "jwt_verify_lib/jwks.h"
+#include "jwt_verify_lib/key_intern_table.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+const std::string RsaJwks = R"(
+{
+  "keys": [
+    {
+      "kty": "RSA",
+      "alg": "RS256",
+      "kid": "rsa",
+      "n": "zgP9Xw2xvul2pZNjCpJD_L16FmKH_zt53seeo2_eBKzcUs3nDO33aYdjsCAAFaQfXSAe0PfmwbytmH9RMHOJPUU2ApcEt63K5-3v5n-kqKfmym2lOebqpLgsdXIXvTsHYYy_10GGM-NPgyMUgU8qJSaPOOA_ZJ1eWQTyfgJCPeIarzcTaf-eSD3CQaDDpi488RFc3O86pho5x3KTHSg4CxHp0ua1RV2pNGJP1BqN0oX09Rgpjo7GE-ukpCMO7zOCwSeBjnqL_zdJ7pjo__u0dhGpdbcejNZhl1NN-0q1eogwJPM295_7xRSW77mmcUI8W4oLDHLz1zxRoX9yK9xv3w",
+      "e": "AQAB"
+    }
+  ]
+}
+)";
+
+bssl::UniquePtr<BIGNUM> bigNum(BN_ULONG value) {
+  bssl::UniquePtr<BIGNUM> bn(BN_new());
+  BN_set_word(bn.get(), value);
+  return bn;
+}
+
+TEST(ValidatedKeyCacheTest, Fingerprint) {
+  auto n1 = bigNum(0x10001);
+  auto n2 = bigNum(0x10003);
+  auto e = bigNum(3);
+  const std::string fingerprint =
+      ValidatedKeyCache::fingerprint(n1.get(), e.get());
+  EXPECT_EQ(fingerprint.size(), 32);
+  EXPECT_EQ(fingerprint, ValidatedKeyCache::fingerprint(n1.get(), e.get()));
+  EXPECT_NE(fingerprint, ValidatedKeyCache::fingerprint(n2.get(), e.get()));
+  // n and e are length-prefixed, so they can not be swapped.
+  EXPECT_NE(fingerprint, ValidatedKeyCache::fingerprint(e.get(), n1.get()));
+  // The loaders share it with the KeyInternTable.
+  EXPECT_EQ(fingerprint, KeyInternTable::rsaThumbprint(n1.get(), e.get()));
+}
+
+TEST(ValidatedKeyCacheTest, BoundedEntries) {
+  ValidatedKeyCache cache(2);
+  EXPECT_TRUE(cache.enabled());
+  cache.insert("a");
+  cache.insert("b");
+  EXPECT_TRUE(cache.contains("a"));
+  cache.insert("c");
+  // "b" was the least recently seen.
+  EXPECT_EQ(cache.entries(), 2);
+  EXPECT_TRUE(cache.contains("a"));
+  EXPECT_FALSE(cache.contains("b"));
+  EXPECT_TRUE(cache.contains("c"));
+
+  cache.setMaxEntries(0);
+  EXPECT_FALSE(cache.enabled());
+  EXPECT_EQ(cache.entries(), 0);
+  cache.insert("a");
+  EXPECT_FALSE(cache.contains("a"));
+}
+
+TEST(ValidatedKeyCacheTest, ConcurrentAccess) {
+  ValidatedKeyCache cache(64);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&cache, i] {
+      for (int j = 0; j < 1000; ++j) {
+        const std::string key = std::to_string((i * 1000 + j) % 100);
+        if (!cache.contains(key)) {
+          cache.insert(key);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(cache.entries(), 64);
+}
+
+TEST(ValidatedKeyCacheTest, DisabledByDefault) {
+  EXPECT_FALSE(ValidatedKeyCache::global().enabled());
+  auto jwks = Jwks::createFrom(RsaJwks, Jwks::JWKS);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+  EXPECT_EQ(ValidatedKeyCache::global().entries(), 0);
+}
+
+TEST(ValidatedKeyCacheTest, JwksLoadRemembersValidKeys) {
+  ValidatedKeyCache& cache = ValidatedKeyCache::global();
+  cache.setMaxEntries(100);
+
+  auto jwks = Jwks::createFrom(RsaJwks, Jwks::JWKS);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+  EXPECT_EQ(cache.entries(), 1);
+  RSA* rsa = jwks->keys()[0]->rsa();
+  EXPECT_TRUE(cache.contains(
+      ValidatedKeyCache::fingerprint(RSA_get0_n(rsa), RSA_get0_e(rsa))));
+
+  // Reloading hits the cache and yields an equally usable key.
+  auto reloaded = Jwks::createFrom(RsaJwks, Jwks::JWKS);
+  ASSERT_EQ(reloaded->getStatus(), Status::Ok);
+  EXPECT_EQ(cache.entries(), 1);
+  EXPECT_EQ(BN_cmp(RSA_get0_n(rsa), RSA_get0_n(reloaded->keys()[0]->rsa())), 0);
+  cache.setMaxEntries(0);
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google
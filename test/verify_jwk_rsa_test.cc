@@ -291,6 +291,21 @@ TEST_F(VerifyJwkRsaTest, LongClaimsWithCorrectKidOk) {
   });
 }
 
+TEST(VerifyJwkRsaLazyTest, LazyKeysOK) {
+  Jwks::LoadOptions options;
+  options.lazy = true;
+  auto jwks = Jwks::createFrom(PublicKeyRSA, Jwks::Type::JWKS, options);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+
+  Jwt jwt;
+  EXPECT_EQ(jwt.parseFromString(JwtTextWithCorrectKid), Status::Ok);
+  EXPECT_EQ(verifyJwt(jwt, *jwks, 1), Status::Ok);
+
+  fuzzJwtSignature(jwt, [&jwks](const Jwt& jwt) {
+    EXPECT_EQ(verifyJwt(jwt, *jwks, 1), Status::JwtVerificationFail);
+  });
+}
+
 }  // namespace
 }  // namespace jwt_verify
 }  // namespace google
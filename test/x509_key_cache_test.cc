@@ -0,0 +1,126 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "jwt_verify_lib/x509_key_cache.h"
+
+#include <map>
+
+#include "absl/strings/escaping.h"
+#include "gtest/gtest.h"
+#include "jwt_verify_lib/jwks.h"
+#include "test/test_common.h"
+
+namespace google {
+namespace jwt_verify {
+namespace {
+
+class X509KeyCacheTest : public testing::Test {
+ protected:
+  void SetUp() override { X509KeyCache::global().setMaxEntries(100); }
+  void TearDown() override { X509KeyCache::global().setMaxEntries(0); }
+
+  // Maps kid to key of a key set.
+  static std::map<std::string, RSA*> keysByKid(const Jwks& jwks) {
+    std::map<std::string, RSA*> keys;
+    for (const auto& key : jwks.keys()) {
+      keys[key->kid_] = key->rsa();
+    }
+    return keys;
+  }
+};
+
+TEST_F(X509KeyCacheTest, RefreshReusesExtractedKeys) {
+  auto jwks = Jwks::createFrom(kPublicKeyX509, Jwks::JWKS);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+  EXPECT_EQ(X509KeyCache::global().entries(), 2);
+
+  auto refreshed = Jwks::createFrom(kPublicKeyX509, Jwks::JWKS);
+  ASSERT_EQ(refreshed->getStatus(), Status::Ok);
+  EXPECT_EQ(X509KeyCache::global().entries(), 2);
+  EXPECT_EQ(keysByKid(*jwks), keysByKid(*refreshed));
+  for (size_t i = 0; i < refreshed->keys().size(); ++i) {
+    const auto& key = refreshed->keys()[i];
+    EXPECT_EQ(key->kty_, "RSA");
+    EXPECT_EQ(key->x509_, nullptr);
+    // The thumbprints are cached with the key.
+    EXPECT_FALSE(key->x5t_.empty());
+    EXPECT_EQ(key->x5t_, jwks->keys()[i]->x5t_);
+    EXPECT_EQ(key->x5t_s256_, jwks->keys()[i]->x5t_s256_);
+    EXPECT_EQ(key->thumbprint_, jwks->keys()[i]->thumbprint_);
+  }
+
+  // Cached keys outlive both the cache entries and the first key set.
+  jwks.reset();
+  X509KeyCache::global().setMaxEntries(0);
+  EXPECT_NE(RSA_size(refreshed->keys()[0]->rsa()), 0);
+}
+
+TEST_F(X509KeyCacheTest, HitSkipsTheCertificate) {
+  auto jwks = Jwks::createFrom(kPublicKeyX509, Jwks::JWKS);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+  const auto& key = jwks->keys()[0];
+
+  // A hit is served from the entry alone: a cached entry of a certificate
+  // that does not even parse is used as is.
+  const std::string cert =
+      "-----BEGIN CERTIFICATE-----\nbm90IGEgY2VydA==\n"
+      "-----END CERTIFICATE-----\n";
+  X509KeyCache::Entry entry;
+  RSA_up_ref(key->rsa());
+  entry.rsa.reset(key->rsa());
+  entry.jwk_thumbprint = "jwk";
+  entry.x5t = "x5t";
+  entry.x5t_s256 = "x5t#S256";
+  X509KeyCache::global().insert(X509KeyCache::fingerprint(cert), entry);
+
+  auto cached = Jwks::createFrom(
+      R"({"kid": ")" + absl::CEscape(cert) + R"("})", Jwks::JWKS);
+  ASSERT_EQ(cached->getStatus(), Status::Ok);
+  ASSERT_EQ(cached->keys().size(), 1);
+  EXPECT_EQ(cached->keys()[0]->rsa(), key->rsa());
+  EXPECT_EQ(cached->keys()[0]->thumbprint_, "jwk");
+  EXPECT_EQ(cached->keys()[0]->x5t_, "x5t");
+  EXPECT_EQ(cached->keys()[0]->x5t_s256_, "x5t#S256");
+}
+
+TEST_F(X509KeyCacheTest, RetainedCertsBypassTheCache) {
+  Jwks::LoadOptions options;
+  options.retain_x509 = true;
+  auto jwks = Jwks::createFrom(kPublicKeyX509, Jwks::JWKS, options);
+  ASSERT_EQ(jwks->getStatus(), Status::Ok);
+  EXPECT_EQ(X509KeyCache::global().entries(), 0);
+  EXPECT_NE(jwks->keys()[0]->x509_, nullptr);
+}
+
+TEST_F(X509KeyCacheTest, Disabled) {
+  X509KeyCache::global().setMaxEntries(0);
+  auto jwks = Jwks::createFrom(kPublicKeyX509, Jwks::JWKS);
+  auto refreshed = Jwks::createFrom(kPublicKeyX509, Jwks::JWKS);
+  EXPECT_EQ(X509KeyCache::global().entries(), 0);
+  EXPECT_NE(keysByKid(*jwks), keysByKid(*refreshed));
+}
+
+TEST_F(X509KeyCacheTest, Fingerprint) {
+  const std::string fingerprint = X509KeyCache::fingerprint("cert");
+  EXPECT_EQ(fingerprint.size(), 32);
+  EXPECT_EQ(fingerprint, X509KeyCache::fingerprint("cert"));
+  EXPECT_NE(fingerprint, X509KeyCache::fingerprint("cert\n"));
+  X509KeyCache::Entry entry;
+  EXPECT_FALSE(X509KeyCache::global().find(fingerprint, &entry));
+  EXPECT_EQ(entry.rsa, nullptr);
+}
+
+}  // namespace
+}  // namespace jwt_verify
+}  // namespace google